@@ -163,6 +163,22 @@ IF (ESCARGOT_THREADING)
     SET (ESCARGOT_DEFINITIONS ${ESCARGOT_DEFINITIONS} -DENABLE_THREADING -DGC_THREAD_ISOLATE)
 ENDIF()
 
+IF (ESCARGOT_SAMPLING_PROFILER)
+    SET (ESCARGOT_DEFINITIONS ${ESCARGOT_DEFINITIONS} -DENABLE_SAMPLING_PROFILER)
+ENDIF()
+
+IF (ESCARGOT_INTERPRETER_STATISTICS)
+    SET (ESCARGOT_DEFINITIONS ${ESCARGOT_DEFINITIONS} -DENABLE_INTERPRETER_STATISTICS)
+ENDIF()
+
+IF (ESCARGOT_GENERATIONAL_GC)
+    # virtual dirty bits of bdwgc are not supported with thread isolated heaps
+    IF (ESCARGOT_THREADING)
+        MESSAGE (FATAL_ERROR "ESCARGOT_GENERATIONAL_GC cannot be used with ESCARGOT_THREADING")
+    ENDIF()
+    SET (ESCARGOT_DEFINITIONS ${ESCARGOT_DEFINITIONS} -DENABLE_GENERATIONAL_GC)
+ENDIF()
+
 #######################################################
 # FLAGS FOR $(MODE) : debug/release
 #######################################################
@@ -62,12 +62,17 @@ IF (${ESCARGOT_OUTPUT} STREQUAL "cctest")
 	FILE (GLOB CCTEST_SRC ${ESCARGOT_ROOT}/test/cctest/testapi.cpp)
 ENDIF()
 
+IF (${ESCARGOT_OUTPUT} STREQUAL "bench")
+	FILE (GLOB BENCH_SRC ${ESCARGOT_ROOT}/test/bench/microbench.cpp)
+ENDIF()
+
 SET (ESCARGOT_SRC_LIST
     ${ESCARGOT_SRC}
     ${YARR_SRC}
     ${DOUBLE_CONVERSION_SRC}
     ${LZ4_SRC}
     ${CCTEST_SRC}
+    ${BENCH_SRC}
 )
 
 # GCUTIL
@@ -176,4 +181,12 @@ ELSEIF (${ESCARGOT_OUTPUT} STREQUAL "cctest")
     TARGET_INCLUDE_DIRECTORIES (${ESCARGOT_CCTEST_TARGET} PRIVATE ${ESCARGOT_INCDIRS})
     TARGET_COMPILE_DEFINITIONS (${ESCARGOT_CCTEST_TARGET} PRIVATE ${ESCARGOT_DEFINITIONS})
     TARGET_COMPILE_OPTIONS (${ESCARGOT_CCTEST_TARGET} PRIVATE ${ESCARGOT_CXXFLAGS} -I${ESCARGOT_ROOT}/third_party/googletest/googletest/include/ ${CXXFLAGS_FROM_ENV})
+
+ELSEIF (${ESCARGOT_OUTPUT} STREQUAL "bench")
+    ADD_EXECUTABLE (${ESCARGOT_BENCH_TARGET} ${ESCARGOT_SRC_LIST})
+
+    TARGET_LINK_LIBRARIES (${ESCARGOT_BENCH_TARGET} ${ESCARGOT_LIBRARIES} ${ESCARGOT_LDFLAGS} ${LDFLAGS_FROM_ENV})
+    TARGET_INCLUDE_DIRECTORIES (${ESCARGOT_BENCH_TARGET} PRIVATE ${ESCARGOT_INCDIRS})
+    TARGET_COMPILE_DEFINITIONS (${ESCARGOT_BENCH_TARGET} PRIVATE ${ESCARGOT_DEFINITIONS})
+    TARGET_COMPILE_OPTIONS (${ESCARGOT_BENCH_TARGET} PRIVATE ${ESCARGOT_CXXFLAGS} ${CXXFLAGS_FROM_ENV})
 ENDIF()
@@ -221,6 +221,7 @@ if (f.type == Type::B) { puts("failed in msvc."); }
 #include <cstdlib>
 #include <cstring>
 #include <cwchar>
+#include <deque>
 #include <functional>
 #include <limits>
 #include <list>
@@ -230,6 +231,7 @@ if (f.type == Type::B) { puts("failed in msvc."); }
 #include <set>
 #include <sstream>
 #include <string>
+#include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -239,11 +241,12 @@ if (f.type == Type::B) { puts("failed in msvc."); }
 #include <stddef.h>
 #endif
 
-#if defined(ENABLE_THREADING)
+#if defined(ENABLE_THREADING) || defined(ENABLE_SAMPLING_PROFILER)
 #include <thread>
 #include <mutex>
 #include <atomic>
 #include <condition_variable>
+#include <chrono>
 #endif
 
 extern "C" {
@@ -503,6 +506,36 @@ typedef uint16_t LexicalBlockIndex;
 #define REGEXP_CACHE_SIZE_MAX 64
 #endif
 
+#ifndef TIMEZONE_OFFSET_CACHE_SIZE
+#define TIMEZONE_OFFSET_CACHE_SIZE 4
+#endif
+
+#ifndef INTL_FORMATTER_CACHE_SIZE_MAX
+#define INTL_FORMATTER_CACHE_SIZE_MAX 16
+#endif
+
+#ifndef STACK_TRACE_DEPTH_LIMIT
+#define STACK_TRACE_DEPTH_LIMIT 128
+#endif
+
+#ifndef BYTECODE_LOC_TABLE_CHECKPOINT_INTERVAL
+#define BYTECODE_LOC_TABLE_CHECKPOINT_INTERVAL 16
+#endif
+
+#ifndef SAMPLING_PROFILER_STACK_DEPTH_LIMIT
+#define SAMPLING_PROFILER_STACK_DEPTH_LIMIT 64
+#endif
+
+// timeline of sampling profiler keeps up to this count of samples (16 bytes per sample)
+#ifndef SAMPLING_PROFILER_SAMPLE_COUNT_LIMIT
+#define SAMPLING_PROFILER_SAMPLE_COUNT_LIMIT (1024 * 1024)
+#endif
+
+// number of minor collections between full collections in generational gc mode
+#ifndef GENERATIONAL_GC_FULL_COLLECTION_FREQUENCY
+#define GENERATIONAL_GC_FULL_COLLECTION_FREQUENCY 16
+#endif
+
 #ifndef ROPE_STRING_MIN_LENGTH
 #define ROPE_STRING_MIN_LENGTH 24
 #endif
@@ -67,6 +67,10 @@
 #include "runtime/BigIntObject.h"
 #include "runtime/SharedArrayBufferObject.h"
 #include "runtime/serialization/Serializer.h"
+#include "runtime/HeapSnapshot.h"
+#if defined(ENABLE_INTERPRETER_STATISTICS)
+#include "interpreter/InterpreterStatistics.h"
+#endif
 #include "interpreter/ByteCode.h"
 #include "api/internal/ValueAdapter.h"
 #if defined(ENABLE_WASM)
@@ -299,6 +303,15 @@ bool Globals::supportsThreading()
 #endif
 }
 
+bool Globals::supportsCodeCache()
+{
+#if defined(ENABLE_CODE_CACHE)
+    return true;
+#else
+    return false;
+#endif
+}
+
 const char* Globals::version()
 {
     return ESCARGOT_VERSION;
@@ -1125,6 +1138,15 @@ void VMInstanceRef::clearCachesRelatedWithContext()
     toImpl(this)->clearCachesRelatedWithContext();
 }
 
+size_t VMInstanceRef::intlFormatterCacheSize()
+{
+#if defined(ENABLE_ICU) && defined(ENABLE_INTL)
+    return toImpl(this)->intlFormatterCacheSize();
+#else
+    return 0;
+#endif
+}
+
 #define DECLARE_GLOBAL_SYMBOLS(name)                      \
     SymbolRef* VMInstanceRef::name##Symbol()              \
     {                                                     \
@@ -1144,6 +1166,109 @@ Evaluator::EvaluatorResult VMInstanceRef::executePendingJob()
     return toEvaluatorResultRef(result);
 }
 
+VMInstanceRef::JobQueueStatistics VMInstanceRef::jobQueueStatistics()
+{
+    JobQueue* jobQueue = toImpl(this)->jobQueue();
+    const JobQueue::Statistics& statistics = jobQueue->statistics();
+
+    JobQueueStatistics result;
+    result.pendingJobCount = jobQueue->pendingJobCount();
+    result.peakPendingJobCount = statistics.m_peakPendingJobCount;
+    result.executedJobCount = statistics.m_executedJobCount;
+    result.drainCount = statistics.m_drainCount;
+    result.lastDrainJobCount = statistics.m_lastDrainJobCount;
+    result.maxDrainJobCount = statistics.m_maxDrainJobCount;
+    return result;
+}
+
+void VMInstanceRef::resetJobQueueStatistics()
+{
+    toImpl(this)->jobQueue()->resetStatistics();
+}
+
+size_t VMInstanceRef::stackTraceDepthLimit()
+{
+    return toImpl(this)->stackTraceDepthLimit();
+}
+
+void VMInstanceRef::setStackTraceDepthLimit(size_t limit)
+{
+    toImpl(this)->setStackTraceDepthLimit(limit);
+}
+
+bool VMInstanceRef::startSamplingProfiler(size_t intervalInMicroseconds)
+{
+#if defined(ENABLE_SAMPLING_PROFILER)
+    return toImpl(this)->startSamplingProfiler(intervalInMicroseconds);
+#else
+    return false;
+#endif
+}
+
+bool VMInstanceRef::stopSamplingProfiler(const char* outputPath)
+{
+#if defined(ENABLE_SAMPLING_PROFILER)
+    return toImpl(this)->stopSamplingProfiler(outputPath);
+#else
+    return false;
+#endif
+}
+
+bool VMInstanceRef::isSamplingProfilerRunning()
+{
+#if defined(ENABLE_SAMPLING_PROFILER)
+    return !!toImpl(this)->samplingProfiler();
+#else
+    return false;
+#endif
+}
+
+bool VMInstanceRef::startAllocationSampler(size_t sampleInterval)
+{
+#if defined(ENABLE_SAMPLING_PROFILER)
+    return toImpl(this)->startAllocationSampler(sampleInterval);
+#else
+    return false;
+#endif
+}
+
+bool VMInstanceRef::stopAllocationSampler(const char* outputPath)
+{
+#if defined(ENABLE_SAMPLING_PROFILER)
+    return toImpl(this)->stopAllocationSampler(outputPath);
+#else
+    return false;
+#endif
+}
+
+bool VMInstanceRef::isAllocationSamplerRunning()
+{
+#if defined(ENABLE_SAMPLING_PROFILER)
+    return !!toImpl(this)->allocationSampler();
+#else
+    return false;
+#endif
+}
+
+bool VMInstanceRef::dumpInterpreterStatistics(const char* outputPath)
+{
+#if defined(ENABLE_INTERPRETER_STATISTICS)
+    return toImpl(this)->interpreterStatistics()->dump(outputPath);
+#else
+    return false;
+#endif
+}
+
+bool VMInstanceRef::resetInterpreterStatistics()
+{
+#if defined(ENABLE_INTERPRETER_STATISTICS)
+    toImpl(this)->interpreterStatistics()->reset();
+    return true;
+#else
+    return false;
+#endif
+}
+
 PersistentRefHolder<ContextRef> ContextRef::create(VMInstanceRef* vminstanceref)
 {
     VMInstance* vminstance = toImpl(vminstanceref);
@@ -2273,6 +2398,19 @@ void ContextRef::setSecurityPolicyCheckCallback(SecurityPolicyCheckCallback cb)
                                                  (void*)cb);
 }
 
+bool ContextRef::writeHeapSnapshot(const char* outputPath)
+{
+    SandBox sb(toImpl(this));
+    auto result = sb.run([](ExecutionState& state, void* data) -> Value {
+        HeapSnapshot snapshot(state);
+        snapshot.build();
+        return Value(snapshot.writeTo((const char*)data));
+    },
+                         (void*)outputPath);
+
+    return result.error.isEmpty() && result.result.isTrue();
+}
+
 OptionalRef<FunctionObjectRef> ExecutionStateRef::resolveCallee()
 {
     auto ec = toImpl(this);
@@ -2359,29 +2497,19 @@ GCManagedVector<Evaluator::StackTraceData> ExecutionStateRef::computeStackTraceD
     SandBox::createStackTraceData(stackTraceData, *state);
 
     GCManagedVector<Evaluator::StackTraceData> result(stackTraceData.size());
-    ByteCodeLOCDataMap locMap;
     for (size_t i = 0; i < stackTraceData.size(); i++) {
         if ((size_t)stackTraceData[i].second.loc.index == SIZE_MAX && (size_t)stackTraceData[i].second.loc.actualCodeBlock != SIZE_MAX) {
             ByteCodeBlock* byteCodeBlock = stackTraceData[i].second.loc.actualCodeBlock;
 
-            ByteCodeLOCData* locData;
-            auto iterMap = locMap.find(byteCodeBlock);
-            if (iterMap == locMap.end()) {
-                locData = new ByteCodeLOCData();
-                locMap.insert(std::make_pair(byteCodeBlock, locData));
-            } else {
-                locData = iterMap->second;
-            }
-
             InterpretedCodeBlock* codeBlock = byteCodeBlock->codeBlock();
             size_t byteCodePosition = stackTraceData[i].second.loc.byteCodePosition;
-            stackTraceData[i].second.loc = byteCodeBlock->computeNodeLOCFromByteCode(state->context(), byteCodePosition, byteCodeBlock->m_codeBlock, locData);
+            stackTraceData[i].second.loc = byteCodeBlock->computeNodeLOCFromByteCode(state->context(), byteCodePosition, byteCodeBlock->m_codeBlock);
             stackTraceData[i].second.src = codeBlock->script()->srcName();
             stackTraceData[i].second.sourceCode = codeBlock->script()->sourceCode();
         }
 
         Evaluator::StackTraceData t;
-        t.src = toRef(stackTraceData[i].second.src);
+        t.src = toRef(stackTraceData[i].second.srcOrNativeFunctionInfo());
         t.sourceCode = toRef(stackTraceData[i].second.sourceCode);
         t.loc.index = stackTraceData[i].second.loc.index;
         t.loc.line = stackTraceData[i].second.loc.line;
@@ -2393,9 +2521,6 @@ GCManagedVector<Evaluator::StackTraceData> ExecutionStateRef::computeStackTraceD
         t.isEval = stackTraceData[i].second.isEval;
         result[i] = t;
     }
-    for (auto iter = locMap.begin(); iter != locMap.end(); iter++) {
-        delete iter->second;
-    }
 
     return result;
 }
@@ -137,6 +137,7 @@ public:
     static void finalizeThread();
 
     static bool supportsThreading();
+    static bool supportsCodeCache();
 
     static const char* version();
     static const char* buildDate();
@@ -661,6 +662,10 @@ public:
     // you can call this function if you don't want to use every alive contexts
     void clearCachesRelatedWithContext();
 
+    // count of Intl formatters cached for locale-sensitive builtins (e.g. Number.prototype.toLocaleString)
+    // always 0 when escargot is built without Intl
+    size_t intlFormatterCacheSize();
+
     SymbolRef* toStringTagSymbol();
     SymbolRef* iteratorSymbol();
     SymbolRef* unscopablesSymbol();
@@ -677,6 +682,46 @@ public:
 
     bool hasPendingJob();
     Evaluator::EvaluatorResult executePendingJob();
+
+    struct ESCARGOT_EXPORT JobQueueStatistics {
+        size_t pendingJobCount;
+        size_t peakPendingJobCount;
+        size_t executedJobCount;
+        // a drain is a sequence of executePendingJob calls which ends with empty queue
+        size_t drainCount;
+        size_t lastDrainJobCount;
+        size_t maxDrainJobCount;
+    };
+
+    JobQueueStatistics jobQueueStatistics();
+    void resetJobQueueStatistics();
+
+    // max count of frames recorded in stack trace of thrown exception
+    size_t stackTraceDepthLimit();
+    void setStackTraceDepthLimit(size_t limit);
+
+    // sampling profiler is available only when escargot is built with ESCARGOT_SAMPLING_PROFILER
+    // every functions return false otherwise
+    // JavaScript stack is sampled every `intervalInMicroseconds` at function entries and loop back-edges
+    bool startSamplingProfiler(size_t intervalInMicroseconds = 1000);
+    // stop profiling and write samples as Chrome DevTools .cpuprofile json into `outputPath`
+    // samples are discarded when `outputPath` is nullptr
+    bool stopSamplingProfiler(const char* outputPath);
+    bool isSamplingProfilerRunning();
+
+    // allocation sampler is available only when escargot is built with ESCARGOT_SAMPLING_PROFILER
+    // every `sampleInterval`th object allocation is recorded with its allocation site
+    bool startAllocationSampler(size_t sampleInterval = 1024);
+    // stop sampling and write allocation sites as json into `outputPath`
+    // samples are discarded when `outputPath` is nullptr
+    bool stopAllocationSampler(const char* outputPath);
+    bool isAllocationSamplerRunning();
+
+    // interpreter statistics are available only when escargot is built with ESCARGOT_INTERPRETER_STATISTICS
+    // every functions return false otherwise
+    // write opcode counts, slow case counts and inline cache misses as text into `outputPath` (stdout if nullptr)
+    bool dumpInterpreterStatistics(const char* outputPath = nullptr);
+    bool resetInterpreterStatistics();
 };
 
 class ESCARGOT_EXPORT ContextRef {
@@ -710,6 +755,9 @@ public:
     VirtualIdentifierCallback virtualIdentifierCallback();
 
     void setSecurityPolicyCheckCallback(SecurityPolicyCheckCallback cb);
+
+    // write objects reachable from this context as Chrome DevTools .heapsnapshot json into `outputPath`
+    bool writeHeapSnapshot(const char* outputPath);
 };
 
 // AtomicStringRef is never deleted by gc until VMInstance destroyed
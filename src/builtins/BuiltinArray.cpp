@@ -68,7 +68,7 @@ Value builtinArrayConstructor(ExecutionState& state, Value thisValue, size_t arg
         if (argc > 1 || !val.isInt32()) {
             if (array->isFastModeArray()) {
                 for (size_t idx = 0; idx < argc; idx++) {
-                    array->m_fastModeData[idx] = argv[idx];
+                    array->setFastModeValue(idx, argv[idx]);
                 }
             } else {
                 for (size_t idx = 0; idx < argc; idx++) {
@@ -86,6 +86,35 @@ Value builtinArrayConstructor(ExecutionState& state, Value thisValue, size_t arg
         ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, ErrorObject::Messages::GlobalObject_InvalidArrayLength); \
     }
 
+// read existing element of fast-mode array without property lookup
+// returns false for non fast-mode array, out of range index or hole. then caller should take the generic path
+// this should be checked for every element because callback can shrink the array or convert it into non-fast mode
+static ALWAYS_INLINE bool tryGetFastModeArrayElement(ExecutionState& state, Object* O, int64_t index, Value& result)
+{
+    if (LIKELY(O->isArrayObject())) {
+        ArrayObject* arr = O->asArrayObject();
+        if (LIKELY(arr->isFastModeArray() && index < arr->arrayLength(state))) {
+            result = arr->getFastModeValue(index);
+            return !result.isEmpty();
+        }
+    }
+    return false;
+}
+
+// store element of fast-mode array when index is in range
+// writing in-range slot of fast-mode array is not observable (every element is writable data property)
+static ALWAYS_INLINE bool trySetFastModeArrayElement(ExecutionState& state, Object* O, int64_t index, const Value& value)
+{
+    if (LIKELY(O->isArrayObject())) {
+        ArrayObject* arr = O->asArrayObject();
+        if (LIKELY(arr->isFastModeArray() && index < arr->arrayLength(state))) {
+            arr->setFastModeValue(index, value);
+            return true;
+        }
+    }
+    return false;
+}
+
 static Object* arraySpeciesCreate(ExecutionState& state, Object* originalArray, const int64_t length)
 {
     ASSERT(originalArray != nullptr);
@@ -386,13 +415,17 @@ static Value builtinArrayJoin(ExecutionState& state, Value thisValue, size_t arg
             }
             builder.appendString(sep);
         }
-        Value elem = thisBinded->getIndexedProperty(state, Value(curIndex)).value(state, thisBinded);
+        Value elem;
+        if (!tryGetFastModeArrayElement(state, thisBinded, curIndex, elem)) {
+            elem = thisBinded->getIndexedProperty(state, Value(curIndex)).value(state, thisBinded);
+        }
 
         if (!elem.isUndefinedOrNull()) {
             builder.appendString(elem.toString(state));
         }
         prevIndex = curIndex;
-        if (elem.isUndefined()) {
+        // skipping holes by enumeration is only worth for sparse(non fast-mode) array
+        if (elem.isUndefined() && !(thisBinded->isArrayObject() && thisBinded->asArrayObject()->isFastModeArray())) {
             struct Data {
                 bool exists;
                 int64_t cur;
@@ -452,6 +485,15 @@ static Value builtinArrayReverse(ExecutionState& state, Value thisValue, size_t
     int64_t lower = 0;
     while (middle > lower) {
         int64_t upper = len - lower - 1;
+        Value lowerFastValue, upperFastValue;
+        if (tryGetFastModeArrayElement(state, O, lower, lowerFastValue) && tryGetFastModeArrayElement(state, O, upper, upperFastValue)) {
+            // swapping existing elements of fast-mode array has no side effect
+            ArrayObject* arr = O->asArrayObject();
+            arr->setFastModeValue(lower, upperFastValue);
+            arr->setFastModeValue(upper, lowerFastValue);
+            lower++;
+            continue;
+        }
         ObjectPropertyName upperP = ObjectPropertyName(state, upper);
         ObjectPropertyName lowerP = ObjectPropertyName(state, lower);
 
@@ -584,6 +626,11 @@ static Value builtinArraySplice(ExecutionState& state, Value thisValue, size_t a
 
     // Repeat, while k < actualDeleteCount
     while (k < actualDeleteCount) {
+        Value fromFastValue;
+        if (tryGetFastModeArrayElement(state, O, actualStart + k, fromFastValue) && trySetFastModeArrayElement(state, A, k, fromFastValue)) {
+            k++;
+            continue;
+        }
         // Let from be ToString(actualStart+k).
         // Let fromPresent be the result of calling the [[HasProperty]] internal method of O with argument from.
         // If fromPresent is true, then
@@ -620,6 +667,11 @@ static Value builtinArraySplice(ExecutionState& state, Value thisValue, size_t a
             int64_t from = k + actualDeleteCount;
             // Let to be ToString(k+itemCount).
             int64_t to = k + itemCount;
+            Value fromFastValue;
+            if (tryGetFastModeArrayElement(state, O, from, fromFastValue) && trySetFastModeArrayElement(state, O, to, fromFastValue)) {
+                k++;
+                continue;
+            }
             // Let fromPresent be the result of calling the [[HasProperty]] internal method of O with argument from.
             ObjectHasPropertyResult fromValue = O->hasIndexedProperty(state, Value(from));
             // If fromPresent is true, then
@@ -655,6 +707,11 @@ static Value builtinArraySplice(ExecutionState& state, Value thisValue, size_t a
         while (k > actualStart) {
             // Let from be ToString(k + actualDeleteCount – 1).
             // Let to be ToString(k + itemCount – 1)
+            Value fromFastValue;
+            if (tryGetFastModeArrayElement(state, O, k + actualDeleteCount - 1, fromFastValue) && trySetFastModeArrayElement(state, O, k + itemCount - 1, fromFastValue)) {
+                k--;
+                continue;
+            }
 
             // Let fromPresent be the result of calling the [[HasProperty]] internal method of O with argument from.
             ObjectHasPropertyResult fromValue = O->hasIndexedProperty(state, Value(k + actualDeleteCount - 1));
@@ -717,6 +774,12 @@ static Value builtinArrayConcat(ExecutionState& state, Value thisValue, size_t a
 
                 // Repeat, while k < len
                 while (k < len) {
+                    Value fastValue;
+                    if (tryGetFastModeArrayElement(state, arr, k, fastValue)) {
+                        obj->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(n + k)), ObjectPropertyDescriptor(fastValue, ObjectPropertyDescriptor::AllPresent));
+                        k++;
+                        continue;
+                    }
                     // Let exists be the result of calling the [[HasProperty]] internal method of E with P.
                     ObjectHasPropertyResult exists = arr->hasIndexedProperty(state, Value(k));
                     if (exists) {
@@ -761,6 +824,12 @@ static Value builtinArraySlice(ExecutionState& state, Value thisValue, size_t ar
     // Let A be ArraySpeciesCreate(O, count).
     Object* ArrayObject = arraySpeciesCreate(state, thisObject, std::max(((int64_t)finalEnd - (int64_t)k), (int64_t)0));
     while (k < finalEnd) {
+        Value fastValue;
+        if (tryGetFastModeArrayElement(state, thisObject, k, fastValue) && trySetFastModeArrayElement(state, ArrayObject, n, fastValue)) {
+            k++;
+            n++;
+            continue;
+        }
         ObjectHasPropertyResult exists = thisObject->hasIndexedProperty(state, Value(k));
         if (exists) {
             ArrayObject->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(n)),
@@ -801,6 +870,13 @@ static Value builtinArrayForEach(ExecutionState& state, Value thisValue, size_t
     int64_t k = 0;
     while (k < len) {
         Value Pk = Value(k);
+        Value fastValue;
+        if (tryGetFastModeArrayElement(state, thisObject, k, fastValue)) {
+            Value args[3] = { fastValue, Pk, thisObject };
+            Object::call(state, callbackfn, T, 3, args);
+            k++;
+            continue;
+        }
         auto res = thisObject->hasProperty(state, ObjectPropertyName(state, Pk));
         if (res) {
             Value kValue = res.value(state, ObjectPropertyName(state, k), thisObject);
@@ -862,6 +938,15 @@ static Value builtinArrayIndexOf(ExecutionState& state, Value thisValue, size_t
 
     // Repeat, while k<len
     while (k < len) {
+        // strict equality comparison has no side effect, so existing elements can be compared directly
+        Value fastValue;
+        if (tryGetFastModeArrayElement(state, O, k, fastValue)) {
+            if (fastValue.equalsTo(state, argv[0])) {
+                return Value(k);
+            }
+            k++;
+            continue;
+        }
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument ToString(k).
         auto kPresent = O->hasIndexedProperty(state, Value(k));
         // If kPresent is true, then
@@ -921,6 +1006,14 @@ static Value builtinArrayLastIndexOf(ExecutionState& state, Value thisValue, siz
 
     // Repeat, while k≥ 0
     while (k >= 0) {
+        Value fastValue;
+        if (tryGetFastModeArrayElement(state, O, k, fastValue)) {
+            if (fastValue.equalsTo(state, argv[0])) {
+                return Value(k);
+            }
+            k--;
+            continue;
+        }
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument ToString(k).
         auto kPresent = O->hasIndexedProperty(state, Value(k));
         // If kPresent is true, then
@@ -970,6 +1063,15 @@ static Value builtinArrayEvery(ExecutionState& state, Value thisValue, size_t ar
     int64_t k = 0;
 
     while (k < len) {
+        Value fastValue;
+        if (tryGetFastModeArrayElement(state, O, k, fastValue)) {
+            Value args[] = { fastValue, Value(k), O };
+            if (!Object::call(state, callbackfn, T, 3, args).toBoolean(state)) {
+                return Value(false);
+            }
+            k++;
+            continue;
+        }
         // Let Pk be ToString(k).
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument Pk.
         auto kPresent = O->hasIndexedProperty(state, Value(k));
@@ -1024,6 +1126,10 @@ static Value builtinArrayFill(ExecutionState& state, Value thisValue, size_t arg
 
     Value value = argv[0];
     while (k < fin) {
+        if (trySetFastModeArrayElement(state, O, k, value)) {
+            k++;
+            continue;
+        }
         O->setIndexedPropertyThrowsException(state, Value(k), value);
         k++;
     }
@@ -1061,6 +1167,16 @@ static Value builtinArrayFilter(ExecutionState& state, Value thisValue, size_t a
     int64_t to = 0;
     // Repeat, while k < len
     while (k < len) {
+        Value fastValue;
+        if (tryGetFastModeArrayElement(state, O, k, fastValue)) {
+            Value v[] = { fastValue, Value(k), O };
+            if (Object::call(state, callbackfn, T, 3, v).toBoolean(state)) {
+                A->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(to)), ObjectPropertyDescriptor(fastValue, ObjectPropertyDescriptor::AllPresent));
+                to++;
+            }
+            k++;
+            continue;
+        }
         // Let Pk be ToString(k).
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument Pk.
         ObjectHasPropertyResult kPresent = O->hasIndexedProperty(state, Value(k));
@@ -1122,6 +1238,17 @@ static Value builtinArrayMap(ExecutionState& state, Value thisValue, size_t argc
 
     // Repeat, while k < len
     while (k < len) {
+        Value fastValue;
+        if (tryGetFastModeArrayElement(state, O, k, fastValue)) {
+            Value v[] = { fastValue, Value(k), O };
+            Value mappedValue = Object::call(state, callbackfn, T, 3, v);
+            // A is created with length len, so storing into it is CreateDataProperty without side effect
+            if (!trySetFastModeArrayElement(state, A, k, mappedValue)) {
+                A->defineOwnPropertyThrowsException(state, ObjectPropertyName(state, k), ObjectPropertyDescriptor(mappedValue, ObjectPropertyDescriptor::AllPresent));
+            }
+            k++;
+            continue;
+        }
         // Let Pk be ToString(k).
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument Pk.
         auto kPresent = O->hasIndexedProperty(state, Value(k));
@@ -1171,6 +1298,15 @@ static Value builtinArraySome(ExecutionState& state, Value thisValue, size_t arg
     int64_t k = 0;
     // Repeat, while k < len
     while (k < len) {
+        Value fastValue;
+        if (tryGetFastModeArrayElement(state, O, k, fastValue)) {
+            Value args[] = { fastValue, Value(k), O };
+            if (Object::call(state, callbackfn, T, 3, args).toBoolean(state)) {
+                return Value(true);
+            }
+            k++;
+            continue;
+        }
         // Let Pk be ToString(k).
         // Let kPresent be the result of calling the [[HasProperty]] internal method of O with argument Pk.
         ObjectHasPropertyResult kPresent = O->hasIndexedProperty(state, Value(k));
@@ -1236,7 +1372,10 @@ static Value builtinArrayIncludes(ExecutionState& state, Value thisValue, size_t
     // Repeat, while k < len
     while (doubleK < len) {
         // Let elementK be the result of ? Get(O, ! ToString(k)).
-        Value elementK = O->get(state, ObjectPropertyName(state, Value(doubleK))).value(state, O);
+        Value elementK;
+        if (!tryGetFastModeArrayElement(state, O, doubleK, elementK)) {
+            elementK = O->get(state, ObjectPropertyName(state, Value(doubleK))).value(state, O);
+        }
         // If SameValueZero(searchElement, elementK) is true, return true.
         if (elementK.equalsToByTheSameValueZeroAlgorithm(state, searchElement)) {
             return Value(true);
@@ -1453,10 +1592,16 @@ static Value builtinArrayPop(ExecutionState& state, Value thisValue, size_t argc
         return Value();
     } else {
         // Else, len > 0
+        Value element;
+        if (tryGetFastModeArrayElement(state, O, len - 1, element) && O->asArrayObject()->isLengthPropertyWritable()) {
+            // shrinking length removes the last element of fast-mode array, so Delete can be omitted
+            O->setThrowsException(state, ObjectPropertyName(state.context()->staticStrings().length), Value(len - 1), O);
+            return element;
+        }
         // Let indx be ToString(len–1).
         ObjectPropertyName indx(state, len - 1);
         // Let element be the result of calling the [[Get]] internal method of O with argument indx.
-        Value element = O->get(state, indx).value(state, O);
+        element = O->get(state, indx).value(state, O);
         // Call the [[Delete]] internal method of O with arguments indx and true.
         O->deleteOwnPropertyThrowsException(state, indx);
         // Call the [[Put]] internal method of O with arguments "length", indx, and true.
@@ -1479,18 +1624,32 @@ static Value builtinArrayPush(ExecutionState& state, Value thisValue, size_t arg
     // If len + argCount > 2^53 - 1, throw a TypeError exception.
     CHECK_ARRAY_LENGTH((uint64_t)n + argc > Value::maximumLength());
 
+    // push(...items) on fast-mode array
+    // expand storage once instead of growing it on every Put
+    if (argc > 1 && O->isArrayObject()) {
+        ArrayObject* arr = O->asArrayObject();
+        if (arr->isFastModeArray() && arr->arrayLength(state) == n && arr->isLengthPropertyWritable() && n + argc <= std::numeric_limits<uint32_t>::max()) {
+            arr->setThrowsException(state, ObjectPropertyName(state.context()->staticStrings().length), Value(n + argc), arr);
+        }
+    }
+
     // Let items be an internal List whose elements are, in left to right order, the arguments that were passed to this function invocation.
     // Repeat, while items is not empty
     // Remove the first element from items and let E be the value of the element.
     for (size_t i = 0; i < argc; i++) {
         // Call the [[Put]] internal method of O with arguments ToString(n), E, and true.
-        O->setIndexedPropertyThrowsException(state, Value(n), argv[i]);
+        if (!trySetFastModeArrayElement(state, O, n, argv[i])) {
+            O->setIndexedPropertyThrowsException(state, Value(n), argv[i]);
+        }
         // Increase n by 1.
         n++;
     }
 
     // Call the [[Put]] internal method of O with arguments "length", n, and true.
-    O->setThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, state.context()->staticStrings().length), Value(n), O);
+    // fast-mode array already has length n after storing items, so Put of same length can be omitted
+    if (argc == 0 || !O->isArrayObject() || !O->asArrayObject()->isFastModeArray() || O->asArrayObject()->arrayLength(state) != n) {
+        O->setThrowsExceptionWhenStrictMode(state, ObjectPropertyName(state, state.context()->staticStrings().length), Value(n), O);
+    }
 
     // Return n.
     return Value(n);
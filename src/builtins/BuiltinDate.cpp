@@ -216,21 +216,32 @@ static Value builtinDateToTimeString(ExecutionState& state, Value thisValue, siz
 }
 
 #if defined(ENABLE_ICU) && defined(ENABLE_INTL)
-#define INTL_DATE_TIME_FORMAT_FORMAT(REQUIRED, DEFUALT)                                                                                         \
-    double x = thisObject->primitiveValue();                                                                                                    \
-    if (std::isnan(x)) {                                                                                                                        \
-        return new ASCIIString("Invalid Date");                                                                                                 \
-    }                                                                                                                                           \
-    Value locales, options;                                                                                                                     \
-    if (argc >= 1) {                                                                                                                            \
-        locales = argv[0];                                                                                                                      \
-    }                                                                                                                                           \
-    if (argc >= 2) {                                                                                                                            \
-        options = argv[1];                                                                                                                      \
-    }                                                                                                                                           \
-    auto dateTimeOption = IntlDateTimeFormatObject::toDateTimeOptions(state, options, String::fromASCII(REQUIRED), String::fromASCII(DEFUALT)); \
-    IntlDateTimeFormatObject* dateFormat = new IntlDateTimeFormatObject(state, locales, dateTimeOption);                                        \
-    auto result = dateFormat->format(state, x);                                                                                                 \
+#define INTL_DATE_TIME_FORMAT_FORMAT(REQUIRED, DEFUALT, KIND)                                                                                       \
+    double x = thisObject->primitiveValue();                                                                                                        \
+    if (std::isnan(x)) {                                                                                                                            \
+        return new ASCIIString("Invalid Date");                                                                                                     \
+    }                                                                                                                                               \
+    Value locales, options;                                                                                                                         \
+    if (argc >= 1) {                                                                                                                                \
+        locales = argv[0];                                                                                                                          \
+    }                                                                                                                                               \
+    if (argc >= 2) {                                                                                                                                \
+        options = argv[1];                                                                                                                          \
+    }                                                                                                                                               \
+    IntlDateTimeFormatObject* dateFormat = nullptr;                                                                                                 \
+    VMInstance* vmInstance = state.context()->vmInstance();                                                                                         \
+    bool canUseCache = VMInstance::canUseIntlFormatterCache(locales, options);                                                                      \
+    if (canUseCache) {                                                                                                                              \
+        dateFormat = (IntlDateTimeFormatObject*)vmInstance->findIntlFormatterCache(VMInstance::KIND, locales);                                      \
+    }                                                                                                                                               \
+    if (!dateFormat) {                                                                                                                              \
+        auto dateTimeOption = IntlDateTimeFormatObject::toDateTimeOptions(state, options, String::fromASCII(REQUIRED), String::fromASCII(DEFUALT)); \
+        dateFormat = new IntlDateTimeFormatObject(state, locales, dateTimeOption);                                                                  \
+        if (canUseCache) {                                                                                                                          \
+            vmInstance->addIntlFormatterCache(VMInstance::KIND, locales, dateFormat);                                                               \
+        }                                                                                                                                           \
+    }                                                                                                                                               \
+    auto result = dateFormat->format(state, x);                                                                                                     \
     return new UTF16String(result.data(), result.length());
 #endif
 
@@ -238,7 +249,7 @@ static Value builtinDateToLocaleString(ExecutionState& state, Value thisValue, s
 {
     RESOLVE_THIS_BINDING_TO_DATE(thisObject, Date, toString);
 #if defined(ENABLE_ICU) && defined(ENABLE_INTL)
-    INTL_DATE_TIME_FORMAT_FORMAT("any", "all")
+    INTL_DATE_TIME_FORMAT_FORMAT("any", "all", IntlDateTimeFormatKind)
 #else
     return thisObject->toLocaleFullString(state);
 #endif
@@ -248,7 +259,7 @@ static Value builtinDateToLocaleDateString(ExecutionState& state, Value thisValu
 {
     RESOLVE_THIS_BINDING_TO_DATE(thisObject, Date, toString);
 #if defined(ENABLE_ICU) && defined(ENABLE_INTL)
-    INTL_DATE_TIME_FORMAT_FORMAT("date", "date")
+    INTL_DATE_TIME_FORMAT_FORMAT("date", "date", IntlDateFormatKind)
 #else
     return thisObject->toLocaleDateString(state);
 #endif
@@ -258,7 +269,7 @@ static Value builtinDateToLocaleTimeString(ExecutionState& state, Value thisValu
 {
     RESOLVE_THIS_BINDING_TO_DATE(thisObject, Date, toString);
 #if defined(ENABLE_ICU) && defined(ENABLE_INTL)
-    INTL_DATE_TIME_FORMAT_FORMAT("time", "time")
+    INTL_DATE_TIME_FORMAT_FORMAT("time", "time", IntlTimeFormatKind)
 #else
     return thisObject->toLocaleTimeString(state);
 #endif
@@ -311,38 +311,245 @@ static void builtinJSONArrayReplacerHelper(ExecutionState& state, ValueVectorWit
     propertyList.push_back(Value(item));
 }
 
-static bool builtinJSONStringifyStr(ExecutionState& state, Value key, Object* holder,
-                                    StaticStrings* strings, Value replacerFunc, ValueVectorWithInlineStorage& stack, String* indent,
-                                    String* gap, bool propertyListTouched, ValueVectorWithInlineStorage& propertyList,
-                                    LargeStringBuilder& product);
-static void builtinJSONStringifyJA(ExecutionState& state, Object* obj,
-                                   StaticStrings* strings, Value replacerFunc, ValueVectorWithInlineStorage& stack, String* indent,
-                                   String* gap, bool propertyListTouched, ValueVectorWithInlineStorage& propertyList,
-                                   LargeStringBuilder& product);
-static void builtinJSONStringifyJO(ExecutionState& state, Object* value,
-                                   StaticStrings* strings, Value replacerFunc, ValueVectorWithInlineStorage& stack, String* indent,
-                                   String* gap, bool propertyListTouched, ValueVectorWithInlineStorage& propertyList,
-                                   LargeStringBuilder& product);
-static void builtinJSONStringifyQuote(ExecutionState& state, Value value, LargeStringBuilder& product);
+static void builtinJSONStringifyQuote(ExecutionState& state, String* value, LargeStringBuilder& product);
+
+#ifndef JSON_STRINGIFY_LINEAR_CYCLE_CHECK_DEPTH
+#define JSON_STRINGIFY_LINEAR_CYCLE_CHECK_DEPTH 16
+#endif
+
+// per-call state of JSON.stringify
+// - cycle detection scans stack linearly for shallow input and switches to hashed set for deep input
+// - indent and separator strings are built once for each depth
+// - enumerable keys of plain object with transition-mode structure are quoted once for each structure
+//   and written with their slot index, so objects sharing structure skip key enumeration and quoting
+class JSONStringifyContext {
+public:
+    struct CachedKey {
+        size_t m_index;
+        String* m_name;
+        String* m_quotedName; // "name": (with trailing space when gap is not empty)
+    };
+
+    struct CachedKeyList : public gc {
+        explicit CachedKeyList(ObjectStructure* structure)
+            : m_structure(structure)
+        {
+        }
+
+        ObjectStructure* m_structure;
+        Vector<CachedKey, GCUtil::gc_malloc_allocator<CachedKey>> m_keys;
+    };
+
+    JSONStringifyContext(StaticStrings* strings, Value replacerFunc, String* gap, bool propertyListTouched, ValueVectorWithInlineStorage& propertyList)
+        : m_strings(strings)
+        , m_replacerFunc(replacerFunc)
+        , m_gap(gap)
+        , m_propertyListTouched(propertyListTouched)
+        , m_propertyList(propertyList)
+    {
+        m_indents.pushBack(String::emptyString);
+        m_separators.pushBack(m_strings->asciiTable[(size_t)','].string());
+    }
+
+    StaticStrings* strings() const { return m_strings; }
+    const Value& replacerFunc() const { return m_replacerFunc; }
+    String* gap() const { return m_gap; }
+    bool propertyListTouched() const { return m_propertyListTouched; }
+    ValueVectorWithInlineStorage& propertyList() { return m_propertyList; }
+
+    void push(ExecutionState& state, Object* obj, const char* errorMessage)
+    {
+        if (LIKELY(m_stack.size() < JSON_STRINGIFY_LINEAR_CYCLE_CHECK_DEPTH)) {
+            for (size_t i = 0; i < m_stack.size(); i++) {
+                if (m_stack[i] == Value(obj)) {
+                    throwCycleError(state, errorMessage);
+                }
+            }
+        } else {
+            if (m_visited.empty()) {
+                for (size_t i = 0; i < m_stack.size(); i++) {
+                    m_visited.insert(m_stack[i].asObject());
+                }
+            }
+            if (!m_visited.insert(obj).second) {
+                throwCycleError(state, errorMessage);
+            }
+        }
+        m_stack.push_back(Value(obj));
+    }
+
+    void pop()
+    {
+        Object* obj = m_stack.back().asObject();
+        m_stack.pop_back();
+        if (UNLIKELY(!m_visited.empty())) {
+            if (m_stack.size() < JSON_STRINGIFY_LINEAR_CYCLE_CHECK_DEPTH) {
+                m_visited.clear();
+            } else {
+                m_visited.erase(obj);
+            }
+        }
+    }
+
+    // writes separator before each element of current array or object
+    void appendSeparator(ExecutionState& state, bool& first, LargeStringBuilder& product)
+    {
+        if (first) {
+            if (m_gap->length()) {
+                product.appendChar('\n');
+                product.appendString(indent(state, m_stack.size()));
+            }
+            first = false;
+        } else {
+            product.appendString(separator(state, m_stack.size()));
+        }
+    }
+
+    // writes line break and indent of outer level before closing bracket
+    void appendStepback(ExecutionState& state, bool first, LargeStringBuilder& product)
+    {
+        if (!first && m_gap->length()) {
+            product.appendChar('\n');
+            product.appendString(indent(state, m_stack.size() - 1));
+        }
+    }
+
+    // returns true if looking up toJSON of obj cannot call user code and finds nothing
+    bool hasNoToJSON(Object* obj)
+    {
+        ObjectStructurePropertyName toJSON(m_strings->toJSON);
+        Optional<Object*> o = obj;
+        while (o) {
+            Object* current = o.value();
+            if (!current->isPlainObject() && !current->isArrayObject()) {
+                return false;
+            }
+            if (current->structure()->findProperty(toJSON).first != SIZE_MAX) {
+                return false;
+            }
+            o = current->rawInternalPrototypeObject();
+        }
+        return true;
+    }
+
+    // returns nullptr if keys of obj should be collected by EnumerableOwnProperties
+    CachedKeyList* cachedKeyList(ExecutionState& state, Object* obj)
+    {
+        if (!obj->isPlainObject()) {
+            return nullptr;
+        }
+        // structure in transition mode is never modified, so its key list is valid as long as object has it
+        ObjectStructure* structure = obj->structure();
+        if (!structure->inTransitionMode() || structure->hasIndexPropertyName()) {
+            return nullptr;
+        }
+
+        auto iter = m_keyListCache.find(structure);
+        if (iter != m_keyListCache.end()) {
+            return iter->second;
+        }
+
+        CachedKeyList* list = new CachedKeyList(structure);
+        size_t count = structure->propertyCount();
+        for (size_t i = 0; i < count; i++) {
+            const ObjectStructureItem& item = structure->readProperty(i);
+            if (!item.m_descriptor.isEnumerable() || !item.m_propertyName.isPlainString()) {
+                continue;
+            }
+            if (!item.m_descriptor.isPlainDataProperty()) {
+                list = nullptr;
+                break;
+            }
+
+            String* name = item.m_propertyName.plainString();
+            LargeStringBuilder builder;
+            builtinJSONStringifyQuote(state, name, builder);
+            builder.appendChar(':');
+            if (m_gap->length()) {
+                builder.appendChar(' ');
+            }
+            list->m_keys.pushBack(CachedKey({ i, name, builder.finalize(&state) }));
+        }
+
+        m_keyListCache.insert(std::make_pair(structure, list));
+        return list;
+    }
+
+    Value cachedKeyValue(ExecutionState& state, Object* obj, CachedKeyList* list, size_t i)
+    {
+        const CachedKey& key = list->m_keys[i];
+        if (LIKELY(obj->structure() == list->m_structure)) {
+            return obj->uncheckedGetOwnDataProperty(key.m_index);
+        }
+        // user code like toJSON of previous value changed the object
+        return obj->get(state, ObjectPropertyName(state, Value(key.m_name))).value(state, obj);
+    }
+
+private:
+    String* indent(ExecutionState& state, size_t depth)
+    {
+        while (m_indents.size() <= depth) {
+            StringBuilder builder;
+            builder.appendString(m_indents.back());
+            builder.appendString(m_gap);
+            m_indents.pushBack(builder.finalize(&state));
+        }
+        return m_indents[depth];
+    }
+
+    String* separator(ExecutionState& state, size_t depth)
+    {
+        if (!m_gap->length()) {
+            return m_separators[0];
+        }
+        while (m_separators.size() <= depth) {
+            StringBuilder builder;
+            builder.appendChar(',');
+            builder.appendChar('\n');
+            builder.appendString(indent(state, m_separators.size()));
+            m_separators.pushBack(builder.finalize(&state));
+        }
+        return m_separators[depth];
+    }
+
+    void throwCycleError(ExecutionState& state, const char* errorMessage)
+    {
+        ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, m_strings->JSON.string(), false, m_strings->stringify.string(), errorMessage);
+    }
+
+    StaticStrings* m_strings;
+    Value m_replacerFunc;
+    String* m_gap;
+    bool m_propertyListTouched;
+    ValueVectorWithInlineStorage& m_propertyList;
+    ValueVectorWithInlineStorage m_stack;
+    std::unordered_set<Object*, std::hash<Object*>, std::equal_to<Object*>, GCUtil::gc_malloc_allocator<Object*>> m_visited;
+    Vector<String*, GCUtil::gc_malloc_allocator<String*>> m_indents;
+    Vector<String*, GCUtil::gc_malloc_allocator<String*>> m_separators;
+    // map is allocated in gc heap, so cached structures are kept alive and their addresses are not reused
+    std::unordered_map<ObjectStructure*, CachedKeyList*, std::hash<ObjectStructure*>, std::equal_to<ObjectStructure*>,
+                       GCUtil::gc_malloc_allocator<std::pair<ObjectStructure* const, CachedKeyList*>>>
+        m_keyListCache;
+};
+
+static void builtinJSONStringifyJA(ExecutionState& state, Object* obj, JSONStringifyContext& context, LargeStringBuilder& product);
+static void builtinJSONStringifyJO(ExecutionState& state, Object* value, JSONStringifyContext& context, LargeStringBuilder& product);
 
 // https://www.ecma-international.org/ecma-262/6.0/#sec-serializejsonproperty
-static bool builtinJSONStringifyStr(ExecutionState& state, Value key, Object* holder,
-                                    StaticStrings* strings, Value replacerFunc, ValueVectorWithInlineStorage& stack,
-                                    String* indent, String* gap, bool propertyListTouched, ValueVectorWithInlineStorage& propertyList,
-                                    LargeStringBuilder& product)
+// step 2 ~ 4 (toJSON, replacer function, unwrapping primitive wrapper)
+static Value builtinJSONStringifyPrepareValue(ExecutionState& state, const Value& key, Object* holder, Value value, JSONStringifyContext& context)
 {
-    Value value = holder->get(state, ObjectPropertyName(state, key)).value(state, holder);
-    if (value.isObject() || value.isBigInt()) {
-        Value toJson = Object::getV(state, value, ObjectPropertyName(state, strings->toJSON));
+    if ((value.isObject() && !context.hasNoToJSON(value.asObject())) || value.isBigInt()) {
+        Value toJson = Object::getV(state, value, ObjectPropertyName(state, context.strings()->toJSON));
         if (toJson.isCallable()) {
             Value arguments[] = { key.toString(state) };
             value = Object::call(state, toJson, value, 1, arguments);
         }
     }
 
-    if (!replacerFunc.isUndefined()) {
+    if (!context.replacerFunc().isUndefined()) {
         Value arguments[] = { key.toString(state), value };
-        value = Object::call(state, replacerFunc, holder, 2, arguments);
+        value = Object::call(state, context.replacerFunc(), holder, 2, arguments);
     }
 
     if (value.isObject()) {
@@ -356,267 +563,246 @@ static bool builtinJSONStringifyStr(ExecutionState& state, Value key, Object* ho
             value = Value(value.asObject()->asBigIntObject()->primitiveValue());
         }
     }
+    return value;
+}
+
+// returns false for value which SerializeJSONProperty returns undefined
+static bool builtinJSONStringifyIsSerializable(const Value& value)
+{
+    return value.isNull() || value.isBoolean() || value.isString() || value.isNumber() || value.isBigInt() || (value.isObject() && !value.isCallable());
+}
+
+// https://www.ecma-international.org/ecma-262/6.0/#sec-serializejsonproperty
+// step 5 ~ 11
+static void builtinJSONStringifySerializeValue(ExecutionState& state, const Value& value, JSONStringifyContext& context, LargeStringBuilder& product)
+{
+    ASSERT(builtinJSONStringifyIsSerializable(value));
+    StaticStrings* strings = context.strings();
     if (value.isNull()) {
         product.appendString(strings->null.string());
-        return true;
-    }
-    if (value.isBoolean()) {
+    } else if (value.isBoolean()) {
         product.appendString(value.asBoolean() ? strings->stringTrue.string() : strings->stringFalse.string());
-        return true;
-    }
-    if (value.isString()) {
+    } else if (value.isString()) {
         builtinJSONStringifyQuote(state, value.asString(), product);
-        return true;
-    }
-    if (value.isNumber()) {
+    } else if (value.isNumber()) {
         double d = value.toNumber(state);
         if (std::isfinite(d)) {
             product.appendString(value.toString(state));
-            return true;
-        }
-        product.appendString(strings->null.string());
-        return true;
-    }
-    if (value.isBigInt()) {
-        ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "Could not serialize a BigInt");
-    }
-    if (value.isObject() && !value.isCallable()) {
-        if (value.asObject()->isArray(state)) {
-            builtinJSONStringifyJA(state, value.asObject(), strings, replacerFunc, stack, indent, gap, propertyListTouched, propertyList, product);
         } else {
-            builtinJSONStringifyJO(state, value.asObject(), strings, replacerFunc, stack, indent, gap, propertyListTouched, propertyList, product);
+            product.appendString(strings->null.string());
         }
-        return true;
+    } else if (value.isBigInt()) {
+        ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, "Could not serialize a BigInt");
+    } else if (value.asObject()->isArray(state)) {
+        builtinJSONStringifyJA(state, value.asObject(), context, product);
+    } else {
+        builtinJSONStringifyJO(state, value.asObject(), context, product);
     }
+}
 
-    return false;
+static bool builtinJSONStringifyStr(ExecutionState& state, Value key, Object* holder, JSONStringifyContext& context, LargeStringBuilder& product)
+{
+    Value value = holder->get(state, ObjectPropertyName(state, key)).value(state, holder);
+    value = builtinJSONStringifyPrepareValue(state, key, holder, value, context);
+    if (!builtinJSONStringifyIsSerializable(value)) {
+        return false;
+    }
+    builtinJSONStringifySerializeValue(state, value, context, product);
+    return true;
 }
 
 // https://www.ecma-international.org/ecma-262/6.0/#sec-serializejsonarray
-static void builtinJSONStringifyJA(ExecutionState& state, Object* obj,
-                                   StaticStrings* strings, Value replacerFunc, ValueVectorWithInlineStorage& stack,
-                                   String* indent, String* gap, bool propertyListTouched, ValueVectorWithInlineStorage& propertyList,
-                                   LargeStringBuilder& product)
+static void builtinJSONStringifyJA(ExecutionState& state, Object* obj, JSONStringifyContext& context, LargeStringBuilder& product)
 {
-    // 1
-    for (size_t i = 0; i < stack.size(); i++) {
-        Value& v = stack[i];
-        if (v == Value(obj)) {
-            ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, strings->JSON.string(), false, strings->stringify.string(), ErrorObject::Messages::GlobalObject_JAError);
-        }
-    }
-    // 2
-    stack.push_back(Value(obj));
-    // 3
-    String* stepback = indent;
-    // 4
-    StringBuilder newIndent;
-    newIndent.appendString(indent);
-    newIndent.appendString(gap);
-    indent = newIndent.finalize(&state);
+    // 1, 2
+    context.push(state, obj, ErrorObject::Messages::GlobalObject_JAError);
 
     // 6, 7
     uint32_t len = obj->length(state);
 
     // Each array element requires at least 1 character for the value, and 1 character for the separator
     if (len / 2 > STRING_MAXIMUM_LENGTH) {
-        ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, strings->JSON.string(), false, strings->stringify.string(), ErrorObject::Messages::GlobalObject_JAError);
+        ErrorObject::throwBuiltinError(state, ErrorObject::RangeError, context.strings()->JSON.string(), false, context.strings()->stringify.string(), ErrorObject::Messages::GlobalObject_JAError);
     }
 
     // 8 ~ 9
-    uint32_t index = 0;
     bool first = true;
-    String* seperator = strings->asciiTable[(size_t)','].string();
-
     product.appendChar('[');
-    while (index < len) {
-        if (first) {
-            if (gap->length()) {
-                product.appendChar('\n');
-                product.appendString(indent);
-                StringBuilder seperatorBuilder;
-                seperatorBuilder.appendChar(',');
-                seperatorBuilder.appendChar('\n');
-                seperatorBuilder.appendString(indent);
-                seperator = seperatorBuilder.finalize(&state);
+    for (uint32_t index = 0; index < len; index++) {
+        context.appendSeparator(state, first, product);
+
+        // read element of fast-mode array directly
+        // array can be changed by toJSON or replacer, so check it for every element
+        Value value(Value::EmptyValue);
+        if (LIKELY(obj->isArrayObject())) {
+            ArrayObject* arr = obj->asArrayObject();
+            if (LIKELY(arr->isFastModeArray() && index < arr->arrayLength(state))) {
+                value = arr->getFastModeValue(index);
             }
-            first = false;
-        } else {
-            product.appendString(seperator);
         }
-
-        bool strP = builtinJSONStringifyStr(state, Value(index), obj, strings, replacerFunc, stack, indent, gap, propertyListTouched, propertyList, product);
-        if (!strP) {
-            product.appendString(strings->null.string());
+        if (value.isEmpty()) {
+            value = obj->get(state, ObjectPropertyName(state, Value(index))).value(state, obj);
         }
-        index++;
-    }
 
-    if (!first && gap->length()) {
-        product.appendChar('\n');
-        product.appendString(stepback);
+        value = builtinJSONStringifyPrepareValue(state, Value(index), obj, value, context);
+        if (builtinJSONStringifyIsSerializable(value)) {
+            builtinJSONStringifySerializeValue(state, value, context, product);
+        } else {
+            product.appendString(context.strings()->null.string());
+        }
     }
 
+    context.appendStepback(state, first, product);
     product.appendChar(']');
 
-    // 11
-    stack.pop_back();
-    // 12
-    indent = stepback;
+    // 11, 12
+    context.pop();
 }
 
 // https://www.ecma-international.org/ecma-262/6.0/#sec-serializejsonobject
-static void builtinJSONStringifyJO(ExecutionState& state, Object* value,
-                                   StaticStrings* strings, Value replacerFunc, ValueVectorWithInlineStorage& stack, String* indent,
-                                   String* gap, bool propertyListTouched, ValueVectorWithInlineStorage& propertyList, LargeStringBuilder& product)
+static void builtinJSONStringifyJO(ExecutionState& state, Object* value, JSONStringifyContext& context, LargeStringBuilder& product)
 {
-    // 1
-    for (size_t i = 0; i < stack.size(); i++) {
-        if (stack[i] == value) {
-            ErrorObject::throwBuiltinError(state, ErrorObject::TypeError, strings->JSON.string(), false, strings->stringify.string(), ErrorObject::Messages::GlobalObject_JOError);
-        }
-    }
-    // 2
-    stack.push_back(Value(value));
-    // 3
-    String* stepback = indent;
-    // 4
-    StringBuilder newIndent;
-    newIndent.appendString(indent);
-    newIndent.appendString(gap);
-    indent = newIndent.finalize(&state);
-    // 5, 6
-    ValueVectorWithInlineStorage k;
-    if (propertyListTouched) {
-        k = propertyList;
-    } else {
-        k = Object::enumerableOwnProperties(state, value, EnumerableOwnPropertiesType::Key);
-    }
+    // 1, 2
+    context.push(state, value, ErrorObject::Messages::GlobalObject_JOError);
 
     // 7 ~ 9
     bool first = true;
-    size_t len = k.size();
-    String* seperator = strings->asciiTable[(size_t)','].string();
-
     product.appendChar('{');
-    LargeStringBuilder subProduct;
-    for (size_t i = 0; i < len; i++) {
-        auto strP = builtinJSONStringifyStr(state, k[i], value, strings, replacerFunc, stack, indent, gap, propertyListTouched, propertyList, subProduct);
-        if (strP) {
-            if (first) {
-                if (gap->length()) {
-                    product.appendChar('\n');
-                    product.appendString(indent);
-                    StringBuilder seperatorBuilder;
-                    seperatorBuilder.appendChar(',');
-                    seperatorBuilder.appendChar('\n');
-                    seperatorBuilder.appendString(indent);
-                    seperator = seperatorBuilder.finalize(&state);
-                }
-                first = false;
-            } else {
-                product.appendString(seperator);
-            }
 
-            builtinJSONStringifyQuote(state, k[i], product);
-            product.appendChar(':');
-            if (gap->length() != 0) {
-                product.appendChar(' ');
+    // 5, 6
+    JSONStringifyContext::CachedKeyList* keyList = context.propertyListTouched() ? nullptr : context.cachedKeyList(state, value);
+    if (keyList) {
+        for (size_t i = 0; i < keyList->m_keys.size(); i++) {
+            const JSONStringifyContext::CachedKey& key = keyList->m_keys[i];
+            Value v = context.cachedKeyValue(state, value, keyList, i);
+            v = builtinJSONStringifyPrepareValue(state, Value(key.m_name), value, v, context);
+            if (builtinJSONStringifyIsSerializable(v)) {
+                context.appendSeparator(state, first, product);
+                product.appendString(key.m_quotedName);
+                builtinJSONStringifySerializeValue(state, v, context, product);
             }
-            product.appendStringBuilder(subProduct);
-            subProduct.clear();
         }
-    }
+    } else {
+        ValueVectorWithInlineStorage k;
+        if (context.propertyListTouched()) {
+            k = context.propertyList();
+        } else {
+            k = Object::enumerableOwnProperties(state, value, EnumerableOwnPropertiesType::Key);
+        }
 
-    if (!first && gap->length()) {
-        product.appendChar('\n');
-        product.appendString(stepback);
+        for (size_t i = 0; i < k.size(); i++) {
+            Value v = value->get(state, ObjectPropertyName(state, k[i])).value(state, value);
+            v = builtinJSONStringifyPrepareValue(state, k[i], value, v, context);
+            if (builtinJSONStringifyIsSerializable(v)) {
+                context.appendSeparator(state, first, product);
+                builtinJSONStringifyQuote(state, k[i].toString(state), product);
+                product.appendChar(':');
+                if (context.gap()->length() != 0) {
+                    product.appendChar(' ');
+                }
+                builtinJSONStringifySerializeValue(state, v, context, product);
+            }
+        }
     }
 
+    context.appendStepback(state, first, product);
     product.appendChar('}');
 
-    // 11
-    stack.pop_back();
-    // 12
-    indent = stepback;
+    // 11, 12
+    context.pop();
+}
+
+static ALWAYS_INLINE bool builtinJSONStringifyNeedsEscape(char16_t c)
+{
+    return c < 0x20 || c == u'\"' || c == u'\\';
+}
+
+// checks 8 latin1 chars at once
+// may report false positive only when there is a char which needs escape in the word
+static ALWAYS_INLINE bool builtinJSONStringifyWordNeedsEscape(uint64_t w)
+{
+    const uint64_t ones = 0x0101010101010101ULL;
+    const uint64_t highBits = 0x8080808080808080ULL;
+    uint64_t quote = w ^ (ones * '\"');
+    uint64_t backslash = w ^ (ones * '\\');
+    uint64_t found = ((w - ones * 0x20) & ~w) | ((quote - ones) & ~quote) | ((backslash - ones) & ~backslash);
+    return found & highBits;
+}
+
+static void builtinJSONStringifyAppendEscaped(char16_t c, LargeStringBuilder& product)
+{
+    product.appendChar('\\');
+    switch (c) {
+    case u'\"':
+    case u'\\':
+        product.appendChar(c);
+        break;
+    case u'\b':
+        product.appendChar('b');
+        break;
+    case u'\f':
+        product.appendChar('f');
+        break;
+    case u'\n':
+        product.appendChar('n');
+        break;
+    case u'\r':
+        product.appendChar('r');
+        break;
+    case u'\t':
+        product.appendChar('t');
+        break;
+    default:
+        ASSERT(c < 0x20);
+        product.appendChar('u');
+        product.appendString(codePointTo4digitString(c));
+        break;
+    }
 }
 
 // https://www.ecma-international.org/ecma-262/6.0/#sec-quotejsonstring
+// chars which need no escape are appended as substring of value
 static void builtinJSONStringifyQuote(ExecutionState& state, String* value, LargeStringBuilder& product)
 {
     auto bad = value->bufferAccessData();
     product.appendChar('"');
-    for (size_t i = 0; i < bad.length; ++i) {
-        char16_t c = bad.charAt(i);
-
-        switch (c) {
-        case u'\"':
-        case u'\\':
-            product.appendChar('\\');
-            product.appendChar(c);
-            break;
-        case u'\b':
-            product.appendChar('\\');
-            product.appendChar('b');
-            break;
-        case u'\f':
-            product.appendChar('\\');
-            product.appendChar('f');
-            break;
-        case u'\n':
-            product.appendChar('\\');
-            product.appendChar('n');
-            break;
-        case u'\r':
-            product.appendChar('\\');
-            product.appendChar('r');
-            break;
-        case u'\t':
-            product.appendChar('\\');
-            product.appendChar('t');
-            break;
-        case 0:
-        case 1:
-        case 2:
-        case 3:
-        case 4:
-        case 5:
-        case 6:
-        case 7:
-        case 11:
-        case 14:
-        case 15:
-        case 16:
-        case 17:
-        case 18:
-        case 19:
-        case 20:
-        case 21:
-        case 22:
-        case 23:
-        case 24:
-        case 25:
-        case 26:
-        case 27:
-        case 28:
-        case 29:
-        case 30:
-        case 31:
-            product.appendChar('\\');
-            product.appendChar('u');
-            product.appendString(codePointTo4digitString(c));
-            break;
-        default:
-            product.appendChar(c);
+
+    size_t runStart = 0;
+    size_t i = 0;
+    if (bad.has8BitContent) {
+        const LChar* buffer = (const LChar*)bad.bufferAs8Bit;
+        while (i < bad.length) {
+            while (i + sizeof(uint64_t) <= bad.length) {
+                uint64_t w;
+                memcpy(&w, buffer + i, sizeof(uint64_t));
+                if (builtinJSONStringifyWordNeedsEscape(w)) {
+                    break;
+                }
+                i += sizeof(uint64_t);
+            }
+            if (i == bad.length) {
+                break;
+            }
+            if (builtinJSONStringifyNeedsEscape(buffer[i])) {
+                product.appendSubString(value, runStart, i);
+                builtinJSONStringifyAppendEscaped(buffer[i], product);
+                runStart = i + 1;
+            }
+            i++;
+        }
+    } else {
+        const char16_t* buffer = bad.bufferAs16Bit;
+        for (; i < bad.length; i++) {
+            if (builtinJSONStringifyNeedsEscape(buffer[i])) {
+                product.appendSubString(value, runStart, i);
+                builtinJSONStringifyAppendEscaped(buffer[i], product);
+                runStart = i + 1;
+            }
         }
     }
-    product.appendChar('"');
-}
 
-static void builtinJSONStringifyQuote(ExecutionState& state, Value value, LargeStringBuilder& product)
-{
-    String* str = value.toString(state);
-    builtinJSONStringifyQuote(state, str, product);
+    product.appendSubString(value, runStart, bad.length);
+    product.appendChar('"');
 }
 
 static Value builtinJSONStringify(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
@@ -627,8 +813,6 @@ static Value builtinJSONStringify(ExecutionState& state, Value thisValue, size_t
     Value value = argv[0];
     Value replacer = argv[1];
     Value space = argv[2];
-    String* indent = String::emptyString;
-    ValueVectorWithInlineStorage stack;
     ValueVectorWithInlineStorage propertyList;
     bool propertyListTouched = false;
 
@@ -704,7 +888,8 @@ static Value builtinJSONStringify(ExecutionState& state, Value thisValue, size_t
     // 10
     wrapper->defineOwnProperty(state, ObjectPropertyName(state, String::emptyString), ObjectPropertyDescriptor(value, ObjectPropertyDescriptor::AllPresent));
     LargeStringBuilder product;
-    auto ret = builtinJSONStringifyStr(state, String::emptyString, wrapper, strings, replacerFunc, stack, indent, gap, propertyListTouched, propertyList, product);
+    JSONStringifyContext context(strings, replacerFunc, gap, propertyListTouched, propertyList);
+    auto ret = builtinJSONStringifyStr(state, String::emptyString, wrapper, context, product);
     if (ret) {
         return product.finalize(&state);
     }
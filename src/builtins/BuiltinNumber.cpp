@@ -20,6 +20,7 @@
 #include "Escargot.h"
 #include "runtime/GlobalObject.h"
 #include "runtime/Context.h"
+#include "runtime/VMInstance.h"
 #include "runtime/NumberObject.h"
 #include "runtime/NativeFunctionObject.h"
 
@@ -274,7 +275,18 @@ static Value builtinNumberToLocaleString(ExecutionState& state, Value thisValue,
 #if defined(ENABLE_ICU) && defined(ENABLE_INTL)
     Value locales = argc > 0 ? argv[0] : Value();
     Value options = argc > 1 ? argv[1] : Value();
-    Object* numberFormat = IntlNumberFormat::create(state, state.context(), locales, options);
+    Object* numberFormat = nullptr;
+    VMInstance* vmInstance = state.context()->vmInstance();
+    bool canUseCache = VMInstance::canUseIntlFormatterCache(locales, options);
+    if (canUseCache) {
+        numberFormat = vmInstance->findIntlFormatterCache(VMInstance::IntlNumberFormatKind, locales);
+    }
+    if (!numberFormat) {
+        numberFormat = IntlNumberFormat::create(state, state.context(), locales, options);
+        if (canUseCache) {
+            vmInstance->addIntlFormatterCache(VMInstance::IntlNumberFormatKind, locales, numberFormat);
+        }
+    }
     double x = 0;
     if (thisValue.isNumber()) {
         x = thisValue.asNumber();
@@ -146,7 +146,18 @@ static Value builtinStringLocaleCompare(ExecutionState& state, Value thisValue,
         options = argv[2];
     }
 
-    Object* collator = IntlCollator::create(state, state.context(), locales, options);
+    Object* collator = nullptr;
+    VMInstance* vmInstance = state.context()->vmInstance();
+    bool canUseCache = VMInstance::canUseIntlFormatterCache(locales, options);
+    if (canUseCache) {
+        collator = vmInstance->findIntlFormatterCache(VMInstance::IntlCollatorKind, locales);
+    }
+    if (!collator) {
+        collator = IntlCollator::create(state, state.context(), locales, options);
+        if (canUseCache) {
+            vmInstance->addIntlFormatterCache(VMInstance::IntlCollatorKind, locales, collator);
+        }
+    }
 
     return Value(IntlCollator::compare(state, collator, S, That));
 #else
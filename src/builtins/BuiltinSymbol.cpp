@@ -89,12 +89,10 @@ static Value builtinSymbolKeyFor(ExecutionState& state, Value thisValue, size_t
     }
     Symbol* sym = argv[0].asSymbol();
     // For each element e of the GlobalSymbolRegistry List (see 19.4.2.1),
-    auto& list = state.context()->vmInstance()->globalSymbolRegistry();
-    for (size_t i = 0; i < list.size(); i++) {
-        // If SameValue(e.[[Symbol]], sym) is true, return e.[[Key]].
-        if (list[i].symbol == sym) {
-            return list[i].key.value();
-        }
+    // If SameValue(e.[[Symbol]], sym) is true, return e.[[Key]].
+    auto key = Symbol::keyForGlobalSymbolRegistry(state.context()->vmInstance(), sym);
+    if (key) {
+        return key.value();
     }
     // Assert: GlobalSymbolRegistry does not currently contain an entry for sym.
     // Return undefined.
@@ -331,7 +331,16 @@ void CodeCacheWriter::storeByteCodeBlock(ByteCodeBlock* block)
     // ByteCodeBlock::m_code bytecode stream
     storeByteCodeStream(block);
 
-    // Do not store m_inlineCacheDataSize and m_locData
+    // ByteCodeBlock::m_locTable
+    if (block->m_locTable) {
+        const ByteCodeLOCTable::EncodedData& locTableData = block->m_locTable->encodedData();
+        m_buffer.putData(locTableData.data(), locTableData.size());
+    } else {
+        m_buffer.ensureSize(sizeof(size_t));
+        m_buffer.put((size_t)0);
+    }
+
+    // Do not store m_inlineCacheDataSize
     // these members are used during the runtime
     ASSERT(block->m_inlineCacheDataSize == 0);
 }
@@ -873,6 +882,15 @@ ByteCodeBlock* CodeCacheReader::loadByteCodeBlock(Context* context, InterpretedC
     // ByteCodeBlock::m_code bytecode stream
     loadByteCodeStream(context, block);
 
+    // ByteCodeBlock::m_locTable
+    size = m_buffer.get<size_t>();
+    if (size) {
+        ByteCodeLOCTable::EncodedData locTableData;
+        locTableData.resizeWithUninitializedValues(size);
+        m_buffer.getData(locTableData.data(), size);
+        block->m_locTable = new ByteCodeLOCTable(std::move(locTableData));
+    }
+
     // finally, relocate opcode address and register index for each bytecode
     ByteCodeGenerator::relocateByteCode(block);
 
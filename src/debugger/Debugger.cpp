@@ -317,7 +317,6 @@ void Debugger::getBacktrace(ExecutionState* state, uint32_t minDepth, uint32_t m
         minDepth = total;
     }
 
-    ByteCodeLOCDataMap locMap;
     uint32_t counter = 0;
 
     for (uint32_t i = 0; i < size && counter < maxDepth; i++) {
@@ -332,16 +331,7 @@ void Debugger::getBacktrace(ExecutionState* state, uint32_t minDepth, uint32_t m
             if ((size_t)stackTraceData[i].second.loc.index == SIZE_MAX) {
                 size_t byteCodePosition = stackTraceData[i].second.loc.byteCodePosition;
 
-                ByteCodeLOCData* locData;
-                auto iterMap = locMap.find(byteCodeBlock);
-                if (iterMap == locMap.end()) {
-                    locData = new ByteCodeLOCData();
-                    locMap.insert(std::make_pair(byteCodeBlock, locData));
-                } else {
-                    locData = iterMap->second;
-                }
-
-                ExtendedNodeLOC loc = byteCodeBlock->computeNodeLOCFromByteCode(state->context(), byteCodePosition, byteCodeBlock->m_codeBlock, locData);
+                ExtendedNodeLOC loc = byteCodeBlock->computeNodeLOCFromByteCode(state->context(), byteCodePosition, byteCodeBlock->m_codeBlock);
                 line = (uint32_t)loc.line;
                 column = (uint32_t)loc.column;
             } else {
@@ -357,10 +347,6 @@ void Debugger::getBacktrace(ExecutionState* state, uint32_t minDepth, uint32_t m
         }
     }
 
-    for (auto iter = locMap.begin(); iter != locMap.end(); iter++) {
-        delete iter->second;
-    }
-
     if (hasSavedStackTrace) {
         SavedStackTraceData* savedStackTracePtr = m_activeSavedStackTrace->begin();
         SavedStackTraceData* savedStackTraceEnd = m_activeSavedStackTrace->end();
@@ -871,7 +857,6 @@ Debugger::SavedStackTraceDataVector* Debugger::saveStackTrace(ExecutionState& st
 {
     SavedStackTraceDataVector* savedStackTrace = new SavedStackTraceDataVector();
     SandBox::StackTraceDataVector stackTraceData;
-    ByteCodeLOCDataMap locMap;
     uint32_t counter = 0;
 
     bool hasSavedStackTrace = SandBox::createStackTraceData(stackTraceData, state, true);
@@ -887,16 +872,7 @@ Debugger::SavedStackTraceDataVector* Debugger::saveStackTrace(ExecutionState& st
             if ((size_t)stackTraceData[i].second.loc.index == SIZE_MAX) {
                 size_t byteCodePosition = stackTraceData[i].second.loc.byteCodePosition;
 
-                ByteCodeLOCData* locData;
-                auto iterMap = locMap.find(byteCodeBlock);
-                if (iterMap == locMap.end()) {
-                    locData = new ByteCodeLOCData();
-                    locMap.insert(std::make_pair(byteCodeBlock, locData));
-                } else {
-                    locData = iterMap->second;
-                }
-
-                ExtendedNodeLOC loc = byteCodeBlock->computeNodeLOCFromByteCode(state.context(), byteCodePosition, byteCodeBlock->m_codeBlock, locData);
+                ExtendedNodeLOC loc = byteCodeBlock->computeNodeLOCFromByteCode(state.context(), byteCodePosition, byteCodeBlock->m_codeBlock);
 
                 line = (uint32_t)loc.line;
                 column = (uint32_t)loc.column;
@@ -909,10 +885,6 @@ Debugger::SavedStackTraceDataVector* Debugger::saveStackTrace(ExecutionState& st
         }
     }
 
-    for (auto iter = locMap.begin(); iter != locMap.end(); iter++) {
-        delete iter->second;
-    }
-
     if (hasSavedStackTrace) {
         Debugger* debugger = state.context()->debugger();
         SavedStackTraceData* savedStackTracePtr = debugger->activeSavedStackTrace()->begin();
@@ -34,6 +34,13 @@ namespace Escargot {
 
 static MAY_THREAD_LOCAL int s_gcKinds[HeapObjectKind::NumberOfKind];
 
+// generational gc mode rescans only objects on dirty pages at minor collection.
+// a store into a field is recorded by the dirty bit of the page holding that field,
+// so every mark procedure below must report pointers only from fields inside the object being marked.
+// iterable procedures walk [addr, addr + size) of the vector itself and sub pointer procedures
+// return addresses of their own members. this is checked in debug build of generational gc mode.
+// buffers which are not scanned (e.g. GC_MALLOC_ATOMIC element buffers of ArrayObject) hold no pointer.
+
 template <GC_get_next_pointer_proc proc>
 GC_ms_entry* markAndPushCustomIterable(GC_word* addr,
                                        struct GC_ms_entry* mark_stack_ptr,
@@ -43,6 +50,19 @@ GC_ms_entry* markAndPushCustomIterable(GC_word* addr,
     return GC_mark_and_push_custom_iterable(addr, mark_stack_ptr, mark_stack_limit, proc);
 }
 
+#if defined(ENABLE_GENERATIONAL_GC) && !defined(NDEBUG)
+template <GC_get_sub_pointer_proc proc, const int number_of_sub_pointer>
+int getSubPointersInsideObject(void* ptr, GC_mark_custom_result* arr)
+{
+    int result = proc(ptr, arr);
+    size_t size = GC_size(ptr);
+    for (int i = 0; i < number_of_sub_pointer; i++) {
+        ASSERT((size_t)arr[i].from >= (size_t)ptr && (size_t)arr[i].from < (size_t)ptr + size);
+    }
+    return result;
+}
+#endif
+
 template <GC_get_sub_pointer_proc proc, const int number_of_sub_pointer>
 GC_ms_entry* markAndPushCustom(GC_word* addr,
                                struct GC_ms_entry* mark_stack_ptr,
@@ -50,7 +70,11 @@ GC_ms_entry* markAndPushCustom(GC_word* addr,
                                GC_word env)
 {
     GC_mark_custom_result subPtrs[number_of_sub_pointer];
+#if defined(ENABLE_GENERATIONAL_GC) && !defined(NDEBUG)
+    return GC_mark_and_push_custom(addr, mark_stack_ptr, mark_stack_limit, getSubPointersInsideObject<proc, number_of_sub_pointer>, subPtrs, number_of_sub_pointer);
+#else
     return GC_mark_and_push_custom(addr, mark_stack_ptr, mark_stack_limit, proc, subPtrs, number_of_sub_pointer);
+#endif
 }
 
 void getNextValidInValueVector(GC_word* ptr, GC_word* end, GC_word** next_ptr, GC_word** from, GC_word** to)
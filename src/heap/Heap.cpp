@@ -34,6 +34,17 @@ void Heap::initialize()
     GC_set_force_unmap_on_gcollect(1);
     initializeCustomAllocators();
 
+#if defined(ENABLE_GENERATIONAL_GC)
+    // generational mode uses dirty bits of pages as write barrier
+    // mark procedures of custom kinds read pointers only from the object itself, so they work with dirty pages
+    // GC_TIME_UNLIMITED keeps marking non-incremental, only minor collections are added
+    if (!GC_is_incremental_mode()) {
+        GC_set_time_limit(GC_TIME_UNLIMITED);
+        GC_set_full_freq(GENERATIONAL_GC_FULL_COLLECTION_FREQUENCY);
+        GC_enable_incremental();
+    }
+#endif
+
 #ifdef PROFILE_BDWGC
     GCUtil::HeapUsageVisualizer::initialize();
 #endif
@@ -23,6 +23,7 @@
 #include "runtime/Context.h"
 #include "runtime/VMInstance.h"
 #include "parser/Lexer.h"
+#include "parser/Script.h"
 #include "parser/ScriptParser.h"
 #include "parser/ast/AST.h"
 #include "parser/esprima_cpp/esprima.h"
@@ -109,6 +110,7 @@ ByteCodeBlock::ByteCodeBlock()
     , m_isOwnerMayFreed(false)
     , m_requiredRegisterFileSizeInValueSize(2)
     , m_inlineCacheDataSize(0)
+    , m_locTable(nullptr)
     , m_codeBlock(nullptr)
 {
     // This constructor is used to allocate a ByteCodeBlock on the stack
@@ -125,6 +127,8 @@ static void clearByteCodeBlock(ByteCodeBlock* self)
     self->m_code.clear();
     self->m_numeralLiteralData.clear();
     self->m_jumpFlowRecordData.clear();
+    delete self->m_locTable;
+    self->m_locTable = nullptr;
 
     if (!self->m_isOwnerMayFreed) {
         auto& v = self->m_codeBlock->context()->vmInstance()->compiledByteCodeBlocks();
@@ -137,6 +141,7 @@ ByteCodeBlock::ByteCodeBlock(InterpretedCodeBlock* codeBlock)
     , m_isOwnerMayFreed(false)
     , m_requiredRegisterFileSizeInValueSize(2)
     , m_inlineCacheDataSize(0)
+    , m_locTable(nullptr)
     , m_codeBlock(codeBlock)
 {
     auto& v = m_codeBlock->context()->vmInstance()->compiledByteCodeBlocks();
@@ -163,50 +168,170 @@ void* ByteCodeBlock::operator new(size_t size)
     return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
 }
 
+static void encodeLEB128(ByteCodeLOCTable::EncodedData& data, uint64_t value)
+{
+    do {
+        uint8_t byte = value & 0x7f;
+        value >>= 7;
+        if (value) {
+            byte |= 0x80;
+        }
+        data.pushBack(byte);
+    } while (value);
+}
+
+static uint64_t decodeLEB128(const uint8_t* data, size_t& offset)
+{
+    uint64_t value = 0;
+    unsigned shift = 0;
+    uint8_t byte;
+    do {
+        byte = data[offset++];
+        value |= (uint64_t)(byte & 0x7f) << shift;
+        shift += 7;
+    } while (byte & 0x80);
+    return value;
+}
+
+ByteCodeLOCTable::ByteCodeLOCTable(const ByteCodeLOCData& locData)
+{
+    // source index is stored as index + 1 so that SIZE_MAX(no location) becomes 0
+    size_t lastCodePosition = 0;
+    uint64_t lastSourceIndex = 0;
+    for (size_t i = 0; i < locData.size(); i++) {
+        ASSERT(locData[i].first >= lastCodePosition);
+        uint64_t sourceIndex = locData[i].second == SIZE_MAX ? 0 : (uint64_t)locData[i].second + 1;
+        int64_t sourceDelta = (int64_t)(sourceIndex - lastSourceIndex);
+
+        encodeLEB128(m_data, locData[i].first - lastCodePosition);
+        // zigzag encoding for signed delta
+        encodeLEB128(m_data, ((uint64_t)sourceDelta << 1) ^ (uint64_t)(sourceDelta >> 63));
+
+        lastCodePosition = locData[i].first;
+        lastSourceIndex = sourceIndex;
+    }
+    m_data.shrinkToFit();
+
+    buildCheckpoints();
+}
+
+ByteCodeLOCTable::ByteCodeLOCTable(EncodedData&& data)
+    : m_data(std::move(data))
+{
+    buildCheckpoints();
+}
+
+void ByteCodeLOCTable::decodeEntry(const uint8_t* data, size_t& offset, size_t& codePosition, size_t& sourceIndex)
+{
+    codePosition += (size_t)decodeLEB128(data, offset);
+
+    uint64_t zigzag = decodeLEB128(data, offset);
+    int64_t sourceDelta = (int64_t)(zigzag >> 1) ^ -(int64_t)(zigzag & 1);
+    uint64_t encodedSourceIndex = (sourceIndex == SIZE_MAX ? 0 : (uint64_t)sourceIndex + 1) + sourceDelta;
+    sourceIndex = encodedSourceIndex ? (size_t)(encodedSourceIndex - 1) : SIZE_MAX;
+}
+
+void ByteCodeLOCTable::buildCheckpoints()
+{
+    const uint8_t* data = m_data.data();
+    size_t offset = 0;
+    size_t codePosition = 0;
+    size_t sourceIndex = SIZE_MAX;
+    size_t count = 0;
+
+    while (offset < m_data.size()) {
+        decodeEntry(data, offset, codePosition, sourceIndex);
+        if (count++ % BYTECODE_LOC_TABLE_CHECKPOINT_INTERVAL == 0) {
+            m_checkpoints.pushBack(Checkpoint{ codePosition, sourceIndex, offset });
+        }
+    }
+    m_checkpoints.shrinkToFit();
+}
+
+bool ByteCodeLOCTable::find(size_t codePosition, size_t& sourceIndex) const
+{
+    // find the last checkpoint located before codePosition
+    size_t lo = 0;
+    size_t hi = m_checkpoints.size();
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (m_checkpoints[mid].codePosition <= codePosition) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    if (lo == 0) {
+        return false;
+    }
+
+    const Checkpoint& checkpoint = m_checkpoints[lo - 1];
+    size_t currentCodePosition = checkpoint.codePosition;
+    size_t currentSourceIndex = checkpoint.sourceIndex;
+    size_t offset = checkpoint.dataOffset;
+    size_t end = lo < m_checkpoints.size() ? m_checkpoints[lo].dataOffset : m_data.size();
+
+    while (true) {
+        if (currentCodePosition == codePosition) {
+            sourceIndex = currentSourceIndex;
+            return true;
+        }
+        if (currentCodePosition > codePosition || offset >= end) {
+            return false;
+        }
+        decodeEntry(m_data.data(), offset, currentCodePosition, currentSourceIndex);
+    }
+}
+
 void ByteCodeBlock::fillLOCData(Context* context, ByteCodeLOCData* locData)
 {
     ASSERT(!!locData && locData->size() == 0);
 
     if (m_codeBlock->src().length() == 0) {
-        // prevent infinate fillLOCData if m_locData.size() == 0 in here
-        locData->push_back(std::make_pair(SIZE_MAX, SIZE_MAX));
         return;
     }
 
     ByteCodeGenerator::collectByteCodeLOCData(context, m_codeBlock, locData);
-
-    // prevent infinate fillLOCData if m_locData.size() == 0 in here
-    locData->push_back(std::make_pair(SIZE_MAX, SIZE_MAX));
 }
 
-ExtendedNodeLOC ByteCodeBlock::computeNodeLOCFromByteCode(Context* c, size_t codePosition, InterpretedCodeBlock* cb, ByteCodeLOCData* locData)
+ByteCodeLOCTable* ByteCodeBlock::ensureLOCTable(Context* context)
 {
-    ASSERT(!!locData);
+    if (!m_locTable) {
+        // bytecode is regenerated only once for each ByteCodeBlock
+        ByteCodeLOCData locData;
+        fillLOCData(context, &locData);
+        m_locTable = new ByteCodeLOCTable(locData);
+    }
+    return m_locTable;
+}
 
+ExtendedNodeLOC ByteCodeBlock::computeNodeLOCFromByteCode(Context* c, size_t codePosition, InterpretedCodeBlock* cb)
+{
     if (codePosition == SIZE_MAX) {
         return ExtendedNodeLOC(SIZE_MAX, SIZE_MAX, SIZE_MAX);
     }
 
-    if (!locData->size()) {
-        fillLOCData(c, locData);
-    }
-
     size_t index = 0;
-    for (size_t i = 0; i < locData->size(); i++) {
-        if ((*locData)[i].first == codePosition) {
-            index = (*locData)[i].second;
-            if (index == SIZE_MAX) {
-                return ExtendedNodeLOC(SIZE_MAX, SIZE_MAX, SIZE_MAX);
-            }
-            break;
-        }
+    if (ensureLOCTable(c)->find(codePosition, index) && index == SIZE_MAX) {
+        return ExtendedNodeLOC(SIZE_MAX, SIZE_MAX, SIZE_MAX);
     }
 
+    ExtendedNodeLOC functionStart = cb->functionStart();
     size_t indexRelatedWithScript = index;
-    index -= cb->functionStart().index;
-
-    auto result = computeNodeLOC(cb->src(), cb->functionStart(), index);
-    result.index = indexRelatedWithScript;
+    size_t clampedIndex = std::min(std::max(index, functionStart.index), functionStart.index + cb->src().length());
+
+    // use line start index of script instead of walking source
+    Script* script = cb->script();
+    size_t startLine = script->lineIndexOf(functionStart.index);
+    size_t line = script->lineIndexOf(clampedIndex);
+
+    ExtendedNodeLOC result(functionStart.line + (line - startLine), 0, indexRelatedWithScript);
+    if (line == startLine) {
+        result.column = functionStart.column + (clampedIndex - functionStart.index);
+    } else {
+        result.column = clampedIndex - script->lineStartIndex(line) + 1;
+    }
 
     return result;
 }
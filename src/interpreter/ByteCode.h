@@ -173,7 +173,7 @@ struct ByteCodeLOC {
     }
 };
 
-#if defined(NDEBUG) && defined(ESCARGOT_32) && !defined(COMPILER_MSVC)
+#if defined(NDEBUG) && defined(ESCARGOT_32) && !defined(COMPILER_MSVC) && !defined(ENABLE_INTERPRETER_STATISTICS)
 #define BYTECODE_SIZE_CHECK_IN_32BIT(codeName, size) COMPILE_ASSERT(sizeof(codeName) == size, "");
 #else
 #define BYTECODE_SIZE_CHECK_IN_32BIT(CodeName, Size)
@@ -190,6 +190,8 @@ public:
 #endif
 #ifndef NDEBUG
         , m_loc(loc)
+#endif
+#if !defined(NDEBUG) || defined(ENABLE_INTERPRETER_STATISTICS)
         , m_orgOpcode(code)
 #endif
     {
@@ -220,8 +222,13 @@ public:
 
 #ifndef NDEBUG
     ByteCodeLOC m_loc;
+#endif
+#if !defined(NDEBUG) || defined(ENABLE_INTERPRETER_STATISTICS)
+    // interpreter statistics reads opcode from here because m_opcodeInAddress holds label address
     Opcode m_orgOpcode;
+#endif
 
+#ifndef NDEBUG
     static void dumpCode(const char* byteCodeStart, const size_t endPos);
     static size_t dumpJumpPosition(size_t pos);
 #endif
@@ -2745,7 +2752,44 @@ typedef Vector<String*, GCUtil::gc_malloc_allocator<String*>> ByteCodeStringLite
 typedef Vector<void*, GCUtil::gc_malloc_allocator<void*>> ByteCodeOtherLiteralData;
 
 typedef std::vector<std::pair<size_t, size_t>, std::allocator<std::pair<size_t, size_t>>> ByteCodeLOCData;
-typedef std::unordered_map<ByteCodeBlock*, ByteCodeLOCData*, std::hash<void*>, std::equal_to<void*>, std::allocator<std::pair<ByteCodeBlock* const, ByteCodeLOCData*>>> ByteCodeLOCDataMap;
+
+// compact table which maps bytecode position into source index
+// each entry is stored as LEB128 encoded deltas from the previous entry
+// and a checkpoint is recorded every BYTECODE_LOC_TABLE_CHECKPOINT_INTERVAL entries for binary search
+class ByteCodeLOCTable {
+public:
+    typedef Vector<uint8_t, std::allocator<uint8_t>> EncodedData;
+
+    explicit ByteCodeLOCTable(const ByteCodeLOCData& locData);
+    explicit ByteCodeLOCTable(EncodedData&& data);
+
+    // returns false if there is no entry for codePosition
+    bool find(size_t codePosition, size_t& sourceIndex) const;
+
+    const EncodedData& encodedData() const
+    {
+        return m_data;
+    }
+
+    size_t memoryAllocatedSize() const
+    {
+        return sizeof(ByteCodeLOCTable) + m_data.capacity() + m_checkpoints.capacity() * sizeof(Checkpoint);
+    }
+
+private:
+    struct Checkpoint {
+        size_t codePosition;
+        size_t sourceIndex;
+        // offset of the next entry in m_data
+        size_t dataOffset;
+    };
+
+    void buildCheckpoints();
+    static void decodeEntry(const uint8_t* data, size_t& offset, size_t& codePosition, size_t& sourceIndex);
+
+    EncodedData m_data;
+    Vector<Checkpoint, std::allocator<Checkpoint>> m_checkpoints;
+};
 
 class ByteCodeBlock : public gc {
 public:
@@ -2848,12 +2892,16 @@ public:
         siz += m_stringLiteralData.size() * sizeof(intptr_t);
         siz += m_otherLiteralData.size() * sizeof(intptr_t);
         siz += m_inlineCacheDataSize;
+        if (m_locTable) {
+            siz += m_locTable->memoryAllocatedSize();
+        }
         return siz;
     }
 
-    ExtendedNodeLOC computeNodeLOCFromByteCode(Context* c, size_t codePosition, InterpretedCodeBlock* cb, ByteCodeLOCData* locData);
+    ExtendedNodeLOC computeNodeLOCFromByteCode(Context* c, size_t codePosition, InterpretedCodeBlock* cb);
     ExtendedNodeLOC computeNodeLOC(StringView src, ExtendedNodeLOC sourceElementStart, size_t index);
     void fillLOCData(Context* c, ByteCodeLOCData* locData);
+    ByteCodeLOCTable* ensureLOCTable(Context* c);
 
     bool m_shouldClearStack : 1;
     bool m_isOwnerMayFreed : 1;
@@ -2869,6 +2917,9 @@ public:
     // m_otherLiteralData only holds various typed addesses not to be deallocated by GC
     ByteCodeOtherLiteralData m_otherLiteralData;
 
+    // built on first location lookup or while generating bytecode for the code cache
+    ByteCodeLOCTable* m_locTable;
+
     InterpretedCodeBlock* m_codeBlock;
 };
 } // namespace Escargot
@@ -189,6 +189,14 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* context, Interpreted
 
     ByteCodeGenerateContext ctx(codeBlock, block, codeBlock->isGlobalScope(), codeBlock->isEvalCode(), inWithFromRuntime || codeBlock->inWith(), nData);
 
+#if defined(ENABLE_CODE_CACHE)
+    // collect location info together to store it in the code cache
+    ByteCodeLOCData locData;
+    if (UNLIKELY(cacheByteCode)) {
+        ctx.m_locData = &locData;
+    }
+#endif
+
 #ifdef ESCARGOT_DEBUGGER
     ByteCodeBreakpointContext breakpointContext(context->debugger() && context->debugger()->parsingEnabled());
     ctx.m_breakpointContext = &breakpointContext;
@@ -215,6 +223,8 @@ ByteCodeBlock* ByteCodeGenerator::generateByteCode(Context* context, Interpreted
 #if defined(ENABLE_CODE_CACHE)
     // cache bytecode right before relocation
     if (UNLIKELY(cacheByteCode)) {
+        ASSERT(!block->m_locTable);
+        block->m_locTable = new ByteCodeLOCTable(locData);
         context->vmInstance()->codeCache()->storeByteCodeBlock(block);
         context->vmInstance()->codeCache()->storeStringTable();
     }
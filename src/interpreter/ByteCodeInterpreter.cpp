@@ -34,6 +34,8 @@
 #include "runtime/EnumerateObject.h"
 #include "runtime/ErrorObject.h"
 #include "runtime/ArrayObject.h"
+#include "runtime/TypedArrayObject.h"
+#include "runtime/TypedArrayInlines.h"
 #include "runtime/VMInstance.h"
 #include "runtime/IteratorObject.h"
 #include "runtime/GeneratorObject.h"
@@ -49,6 +51,12 @@
 #include "runtime/ScriptAsyncGeneratorFunctionObject.h"
 #include "parser/ScriptParser.h"
 #include "CheckedArithmetic.h"
+#if defined(ENABLE_SAMPLING_PROFILER)
+#include "runtime/SamplingProfiler.h"
+#endif
+#if defined(ENABLE_INTERPRETER_STATISTICS)
+#include "interpreter/InterpreterStatistics.h"
+#endif
 
 namespace Escargot {
 
@@ -102,6 +110,43 @@ private:
     T m_changer;
 };
 
+#if defined(ENABLE_SAMPLING_PROFILER)
+// sample is taken only at function entries and jumps to keep the check off from other opcodes
+#define TAKE_SAMPLE_IF_REQUESTED()                                              \
+    if (UNLIKELY(state->context()->vmInstance()->isSampleRequested())) {        \
+        state->context()->vmInstance()->samplingProfiler()->takeSample(*state); \
+    }
+#else
+#define TAKE_SAMPLE_IF_REQUESTED()
+#endif
+
+#if defined(ENABLE_INTERPRETER_STATISTICS)
+#define DECLARE_INTERPRETER_STATISTICS()                                                        \
+    InterpreterStatistics* statistics = state->context()->vmInstance()->interpreterStatistics(); \
+    InterpreterStatistics::BlockCounters* blockCounters = statistics->countersFor(byteCodeBlock);
+#define COUNT_INSTRUCTION() \
+    statistics->countInstruction(blockCounters, ((ByteCode*)programCounter)->m_orgOpcode);
+#define COUNT_SLOW_CASE(opcode) \
+    statistics->countSlowCase(blockCounters, opcode##Opcode);
+#define COUNT_INLINE_CACHE_ACCESS() \
+    statistics->countInlineCacheAccess(blockCounters, programCounter - (size_t)codeBuffer);
+#define COUNT_INLINE_CACHE_MISS() \
+    statistics->countInlineCacheMiss(blockCounters, programCounter - (size_t)codeBuffer);
+
+// used by cache miss functions which are out of interpret function
+static void countInlineCacheMiss(ExecutionState& state, ByteCodeBlock* block, ByteCode* code)
+{
+    InterpreterStatistics* statistics = state.context()->vmInstance()->interpreterStatistics();
+    statistics->countInlineCacheMiss(statistics->countersFor(block), (size_t)code - (size_t)block->m_code.data());
+}
+#else
+#define DECLARE_INTERPRETER_STATISTICS()
+#define COUNT_INSTRUCTION()
+#define COUNT_SLOW_CASE(opcode)
+#define COUNT_INLINE_CACHE_ACCESS()
+#define COUNT_INLINE_CACHE_MISS()
+#endif
+
 Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteCodeBlock, size_t programCounter, Value* registerFile)
 {
 #if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
@@ -117,11 +162,14 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         ExecutionStateProgramCounterBinder binder(*state, &programCounter);
         char* codeBuffer = byteCodeBlock->m_code.data();
         programCounter = (size_t)(codeBuffer + programCounter);
+        TAKE_SAMPLE_IF_REQUESTED();
+        DECLARE_INTERPRETER_STATISTICS();
 
 #if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
 #define DEFINE_OPCODE(codeName) codeName##OpcodeLbl
 #define DEFINE_DEFAULT
 #define NEXT_INSTRUCTION() \
+    COUNT_INSTRUCTION();   \
     goto*(((ByteCode*)programCounter)->m_opcodeInAddress);
 #define JUMP_INSTRUCTION(opcode) \
     goto opcode##OpcodeLbl;
@@ -136,6 +184,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         RELEASE_ASSERT_NOT_REACHED(); \
         }
 #define NEXT_INSTRUCTION() \
+    COUNT_INSTRUCTION();   \
     goto NextInstruction;
 #define JUMP_INSTRUCTION(opcode)    \
     currentOpcode = opcode##Opcode; \
@@ -194,7 +243,10 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                     registerFile[code->m_registerIndex] = val;
                 }
             }
+            COUNT_INLINE_CACHE_ACCESS();
             if (UNLIKELY(!isCacheWork)) {
+                COUNT_INLINE_CACHE_MISS();
+                COUNT_SLOW_CASE(GetGlobalVariable);
                 registerFile[code->m_registerIndex] = getGlobalVariableSlowCase(*state, globalObject, slot, byteCodeBlock);
             }
             ADD_PROGRAM_COUNTER(GetGlobalVariable);
@@ -232,7 +284,10 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                 }
             }
 
+            COUNT_INLINE_CACHE_ACCESS();
             if (UNLIKELY(!isCacheWork)) {
+                COUNT_INLINE_CACHE_MISS();
+                COUNT_SLOW_CASE(SetGlobalVariable);
                 setGlobalVariableSlowCase(*state, globalObject, slot, registerFile[code->m_registerIndex], byteCodeBlock);
             }
 
@@ -260,6 +315,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             } else if (v0.isNumber() && v1.isNumber()) {
                 ret = Value(v0.asNumber() + v1.asNumber());
             } else {
+                COUNT_SLOW_CASE(BinaryPlus);
                 ret = plusSlowCase(*state, v0, v1);
             }
             registerFile[code->m_dstIndex] = ret;
@@ -287,6 +343,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             } else if (LIKELY(left.isNumber() && right.isNumber())) {
                 ret = Value(left.asNumber() - right.asNumber());
             } else {
+                COUNT_SLOW_CASE(BinaryMinus);
                 ret = minusSlowCase(*state, left, right);
             }
             registerFile[code->m_dstIndex] = ret;
@@ -318,6 +375,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             } else if (LIKELY(left.isNumber() && right.isNumber())) {
                 ret = Value(Value::EncodeAsDouble, left.asNumber() * right.asNumber());
             } else {
+                COUNT_SLOW_CASE(BinaryMultiply);
                 ret = multiplySlowCase(*state, left, right);
             }
             registerFile[code->m_dstIndex] = ret;
@@ -334,6 +392,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             if (LIKELY(left.isNumber() && right.isNumber())) {
                 registerFile[code->m_dstIndex] = Value(left.asNumber() / right.asNumber());
             } else {
+                COUNT_SLOW_CASE(BinaryDivision);
                 registerFile[code->m_dstIndex] = divisionSlowCase(*state, left, right);
             }
             ADD_PROGRAM_COUNTER(BinaryDivision);
@@ -488,7 +547,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                 if (LIKELY(arr->isFastModeArray())) {
                     uint32_t idx = property.tryToUseAsIndexProperty(*state);
                     if (LIKELY(idx != Value::InvalidIndexPropertyValue) && LIKELY(idx < arr->arrayLength(*state))) {
-                        const Value& v = arr->m_fastModeData[idx];
+                        const Value& v = arr->getFastModeValue(idx);
                         if (LIKELY(!v.isEmpty())) {
                             registerFile[code->m_storeRegisterIndex] = v;
                             ADD_PROGRAM_COUNTER(GetObject);
@@ -496,6 +555,16 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                         }
                     }
                 }
+            } else if (willBeObject.isObject() && property.isUInt32() && v->isTypedArrayObject()) {
+                // read element of TypedArray directly from its buffer
+                TypedArrayObject* ta = v->asTypedArrayObject();
+                uint32_t idx = property.asUInt32();
+                if (LIKELY(idx < ta->arrayLength() && !ta->buffer()->isDetachedBuffer())) {
+                    TypedArrayType type = ta->typedArrayType();
+                    registerFile[code->m_storeRegisterIndex] = TypedArrayHelper::rawBytesToNumber(*state, type, ta->rawBuffer() + idx * TypedArrayHelper::elementSize(type));
+                    ADD_PROGRAM_COUNTER(GetObject);
+                    NEXT_INSTRUCTION();
+                }
             }
             JUMP_INSTRUCTION(GetObjectOpcodeSlowCase);
         }
@@ -520,11 +589,24 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                                 JUMP_INSTRUCTION(SetObjectOpcodeSlowCase);
                             }
                         }
-                        arr->m_fastModeData[idx] = registerFile[code->m_loadRegisterIndex];
+                        arr->setFastModeValue(idx, registerFile[code->m_loadRegisterIndex]);
                         ADD_PROGRAM_COUNTER(SetObjectOperation);
                         NEXT_INSTRUCTION();
                     }
                 }
+            } else if (willBeObject.isObject() && property.isUInt32() && willBeObject.asPointerValue()->isTypedArrayObject()) {
+                // store number into TypedArray directly
+                // converting number into native type has no side effect, so we can skip the generic path
+                TypedArrayObject* ta = willBeObject.asPointerValue()->asTypedArrayObject();
+                const Value& value = registerFile[code->m_loadRegisterIndex];
+                uint32_t idx = property.asUInt32();
+                TypedArrayType type = ta->typedArrayType();
+                if (LIKELY(value.isNumber() && idx < ta->arrayLength() && !ta->buffer()->isDetachedBuffer())
+                    && LIKELY(type != TypedArrayType::BigInt64 && type != TypedArrayType::BigUint64)) {
+                    TypedArrayHelper::numberToRawBytes(*state, type, value, ta->rawBuffer() + idx * TypedArrayHelper::elementSize(type));
+                    ADD_PROGRAM_COUNTER(SetObjectOperation);
+                    NEXT_INSTRUCTION();
+                }
             }
             JUMP_INSTRUCTION(SetObjectOpcodeSlowCase);
         }
@@ -540,6 +622,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             } else {
                 obj = fastToObject(*state, willBeObject);
             }
+            COUNT_INLINE_CACHE_ACCESS();
             registerFile[code->m_storeRegisterIndex] = getObjectPrecomputedCaseOperation(*state, obj, willBeObject, code, byteCodeBlock);
             ADD_PROGRAM_COUNTER(GetObjectPreComputedCase);
             NEXT_INSTRUCTION();
@@ -549,6 +632,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             :
         {
             SetObjectPreComputedCase* code = (SetObjectPreComputedCase*)programCounter;
+            COUNT_INLINE_CACHE_ACCESS();
             setObjectPreComputedCaseOperation(*state, registerFile[code->m_objectRegisterIndex], registerFile[code->m_loadRegisterIndex], code, byteCodeBlock);
             ADD_PROGRAM_COUNTER(SetObjectPreComputedCase);
             NEXT_INSTRUCTION();
@@ -559,6 +643,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
         {
             Jump* code = (Jump*)programCounter;
             ASSERT(code->m_jumpPosition != SIZE_MAX);
+            TAKE_SAMPLE_IF_REQUESTED();
             programCounter = code->m_jumpPosition;
             NEXT_INSTRUCTION();
         }
@@ -604,6 +689,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             JumpIfTrue* code = (JumpIfTrue*)programCounter;
             ASSERT(code->m_jumpPosition != SIZE_MAX);
             if (registerFile[code->m_registerIndex].toBoolean(*state)) {
+                TAKE_SAMPLE_IF_REQUESTED();
                 programCounter = code->m_jumpPosition;
             } else {
                 ADD_PROGRAM_COUNTER(JumpIfTrue);
@@ -710,6 +796,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             UnaryMinus* code = (UnaryMinus*)programCounter;
             const Value& val = registerFile[code->m_srcIndex];
             if (UNLIKELY(val.isPointerValue())) {
+                COUNT_SLOW_CASE(UnaryMinus);
                 registerFile[code->m_dstIndex] = unaryMinusSlowCase(*state, val);
             } else {
                 registerFile[code->m_dstIndex] = Value(-val.toNumber(*state));
@@ -738,6 +825,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             if (left.isInt32() && right.isInt32()) {
                 registerFile[code->m_dstIndex] = Value(left.asInt32() & right.asInt32());
             } else {
+                COUNT_SLOW_CASE(BinaryBitwiseAnd);
                 registerFile[code->m_dstIndex] = bitwiseOperationSlowCase(*state, left, right, BitwiseOperationKind::And);
             }
             ADD_PROGRAM_COUNTER(BinaryBitwiseAnd);
@@ -753,6 +841,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             if (left.isInt32() && right.isInt32()) {
                 registerFile[code->m_dstIndex] = Value(left.asInt32() | right.asInt32());
             } else {
+                COUNT_SLOW_CASE(BinaryBitwiseOr);
                 registerFile[code->m_dstIndex] = bitwiseOperationSlowCase(*state, left, right, BitwiseOperationKind::Or);
             }
             ADD_PROGRAM_COUNTER(BinaryBitwiseOr);
@@ -768,6 +857,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             if (left.isInt32() && right.isInt32()) {
                 registerFile[code->m_dstIndex] = Value(left.asInt32() ^ right.asInt32());
             } else {
+                COUNT_SLOW_CASE(BinaryBitwiseXor);
                 registerFile[code->m_dstIndex] = bitwiseOperationSlowCase(*state, left, right, BitwiseOperationKind::Xor);
             }
             ADD_PROGRAM_COUNTER(BinaryBitwiseXor);
@@ -786,6 +876,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                 lnum <<= ((unsigned int)rnum) & 0x1F;
                 registerFile[code->m_dstIndex] = Value(lnum);
             } else {
+                COUNT_SLOW_CASE(BinaryLeftShift);
                 registerFile[code->m_dstIndex] = shiftOperationSlowCase(*state, left, right, ShiftOperationKind::Left);
             }
             ADD_PROGRAM_COUNTER(BinaryLeftShift);
@@ -804,6 +895,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                 lnum >>= ((unsigned int)rnum) & 0x1F;
                 registerFile[code->m_dstIndex] = Value(lnum);
             } else {
+                COUNT_SLOW_CASE(BinarySignedRightShift);
                 registerFile[code->m_dstIndex] = shiftOperationSlowCase(*state, left, right, ShiftOperationKind::SignedRight);
             }
             ADD_PROGRAM_COUNTER(BinarySignedRightShift);
@@ -822,6 +914,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
                 lnum = (lnum) >> ((rnum)&0x1F);
                 registerFile[code->m_dstIndex] = Value(lnum);
             } else {
+                COUNT_SLOW_CASE(BinaryUnsignedRightShift);
                 registerFile[code->m_dstIndex] = shiftOperationSlowCase(*state, left, right, ShiftOperationKind::UnsignedRight);
             }
             ADD_PROGRAM_COUNTER(BinaryUnsignedRightShift);
@@ -847,6 +940,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             if (val.isInt32()) {
                 registerFile[code->m_dstIndex] = Value(~val.asInt32());
             } else {
+                COUNT_SLOW_CASE(UnaryBitwiseNot);
                 registerFile[code->m_dstIndex] = bitwiseNotOperationSlowCase(*state, val);
             }
             ADD_PROGRAM_COUNTER(UnaryBitwiseNot);
@@ -973,6 +1067,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             :
         {
             GetObject* code = (GetObject*)programCounter;
+            COUNT_SLOW_CASE(GetObject);
             getObjectOpcodeSlowCase(*state, code, registerFile);
             ADD_PROGRAM_COUNTER(GetObject);
             NEXT_INSTRUCTION();
@@ -982,6 +1077,7 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             :
         {
             SetObjectOperation* code = (SetObjectOperation*)programCounter;
+            COUNT_SLOW_CASE(SetObjectOperation);
             setObjectOpcodeSlowCase(*state, code, registerFile);
             ADD_PROGRAM_COUNTER(SetObjectOperation);
             NEXT_INSTRUCTION();
@@ -1121,6 +1217,14 @@ Value ByteCodeInterpreter::interpret(ExecutionState* state, ByteCodeBlock* byteC
             :
         {
             ThrowOperation* code = (ThrowOperation*)programCounter;
+            ExecutionState* parent = state->parent();
+            if (parent && parent->onTry()) {
+                // this frame is try block of the parent
+                // pass the exception to tryOperation directly instead of unwinding
+                state->context()->vmInstance()->currentSandBox()->setPendingException(*state, registerFile[code->m_registerIndex]);
+                state->m_hasPendingException = true;
+                return Value(Value::EmptyValue);
+            }
             state->context()->throwException(*state, registerFile[code->m_registerIndex]);
         }
 
@@ -2104,6 +2208,9 @@ ALWAYS_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperation(Execu
 
 NEVER_INLINE Value ByteCodeInterpreter::getObjectPrecomputedCaseOperationCacheMiss(ExecutionState& state, Object* obj, const Value& receiver, GetObjectPreComputedCase* code, ByteCodeBlock* block)
 {
+#if defined(ENABLE_INTERPRETER_STATISTICS)
+    countInlineCacheMiss(state, block, code);
+#endif
     if (code->m_isLength && obj->isArrayObject()) {
         return Value(obj->asArrayObject()->arrayLength(state));
     }
@@ -2257,6 +2364,9 @@ ALWAYS_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperation(Execut
 
 NEVER_INLINE void ByteCodeInterpreter::setObjectPreComputedCaseOperationCacheMiss(ExecutionState& state, Object* originalObject, const Value& willBeObject, const Value& value, SetObjectPreComputedCase* code, ByteCodeBlock* block)
 {
+#if defined(ENABLE_INTERPRETER_STATISTICS)
+    countInlineCacheMiss(state, block, code);
+#endif
     if (code->m_isLength && originalObject->isArrayObject() && originalObject->asArrayObject()->isFastModeArray()) {
         if (!originalObject->asArrayObject()->setArrayLength(state, value) && state.inStrictMode()) {
             ErrorObject::throwBuiltinError(state, ErrorObject::Code::TypeError, code->m_propertyName.toExceptionString(), false, String::emptyString, ErrorObject::Messages::DefineProperty_NotWritable);
@@ -2603,6 +2713,7 @@ NEVER_INLINE Value ByteCodeInterpreter::tryOperation(ExecutionState*& state, siz
     SandBox::StackTraceDataVector stackTraceData;
 
     if (LIKELY(!code->m_isCatchResumeProcess && !code->m_isFinallyResumeProcess)) {
+        Optional<Value> caughtValue;
         try {
             ExecutionStateVariableChanger<void (*)(ExecutionState&, bool)> changer(*state, [](ExecutionState& state, bool in) {
                 state.m_onTry = in;
@@ -2610,23 +2721,34 @@ NEVER_INLINE Value ByteCodeInterpreter::tryOperation(ExecutionState*& state, siz
 
             size_t newPc = programCounter + sizeof(TryOperation);
             interpret(newState, byteCodeBlock, resolveProgramCounter(codeBuffer, newPc), registerFile);
-            if (newState->inExecutionStopState()) {
-                return Value();
-            }
-            if (UNLIKELY(code->m_isTryResumeProcess && newState->parent()->inExecutionStopState())) {
-                return Value();
-            }
-            clearStack<512>();
-            if (UNLIKELY(code->m_isTryResumeProcess)) {
+            if (UNLIKELY(newState->m_hasPendingException)) {
+                // ThrowOperation in try block returned without unwinding
+                newState->m_hasPendingException = false;
+                caughtValue = newState->context()->vmInstance()->currentSandBox()->m_exception;
+            } else {
+                if (newState->inExecutionStopState()) {
+                    return Value();
+                }
+                if (UNLIKELY(code->m_isTryResumeProcess && newState->parent()->inExecutionStopState())) {
+                    return Value();
+                }
+                clearStack<512>();
+                if (UNLIKELY(code->m_isTryResumeProcess)) {
 #ifdef ESCARGOT_DEBUGGER
-                Debugger::updateStopState(state->context()->debugger(), newState, ESCARGOT_DEBUGGER_ALWAYS_STOP);
+                    Debugger::updateStopState(state->context()->debugger(), newState, ESCARGOT_DEBUGGER_ALWAYS_STOP);
 #endif /* ESCARGOT_DEBUGGER */
-                state = newState->parent();
-                code = (TryOperation*)(byteCodeBlock->m_code.data() + newState->rareData()->m_programCounterWhenItStoppedByYield);
-                newState = new ExecutionState(state, state->lexicalEnvironment(), state->inStrictMode());
-                newState->ensureRareData()->m_controlFlowRecord = state->rareData()->m_controlFlowRecord;
+                    state = newState->parent();
+                    code = (TryOperation*)(byteCodeBlock->m_code.data() + newState->rareData()->m_programCounterWhenItStoppedByYield);
+                    newState = new ExecutionState(state, state->lexicalEnvironment(), state->inStrictMode());
+                    newState->ensureRareData()->m_controlFlowRecord = state->rareData()->m_controlFlowRecord;
+                }
             }
         } catch (const Value& val) {
+            caughtValue = val;
+        }
+
+        if (UNLIKELY(caughtValue.hasValue())) {
+            const Value val = caughtValue.value();
             if (UNLIKELY(code->m_isTryResumeProcess)) {
 #ifdef ESCARGOT_DEBUGGER
                 Debugger::updateStopState(state->context()->debugger(), newState, ESCARGOT_DEBUGGER_ALWAYS_STOP);
@@ -3476,7 +3598,7 @@ NEVER_INLINE void ByteCodeInterpreter::spreadFunctionArguments(ExecutionState& s
             ArrayObject* spreadArray = arg.asObject()->asArrayObject();
             ASSERT(spreadArray->isFastModeArray());
             for (size_t i = 0; i < spreadArray->arrayLength(state); i++) {
-                argVector.push_back(spreadArray->m_fastModeData[i]);
+                argVector.push_back(spreadArray->getFastModeValue(i));
             }
         } else {
             argVector.push_back(arg);
@@ -3693,7 +3815,7 @@ NEVER_INLINE void ByteCodeInterpreter::arrayDefineOwnPropertyOperation(Execution
     if (LIKELY(arr->isFastModeArray())) {
         for (size_t i = 0; i < code->m_count; i++) {
             if (LIKELY(code->m_loadRegisterIndexs[i] != REGISTER_LIMIT)) {
-                arr->m_fastModeData[i + code->m_baseIndex] = registerFile[code->m_loadRegisterIndexs[i]];
+                arr->setFastModeValue(i + code->m_baseIndex, registerFile[code->m_loadRegisterIndexs[i]]);
             }
         }
     } else {
@@ -3734,11 +3856,11 @@ NEVER_INLINE void ByteCodeInterpreter::arrayDefineOwnPropertyBySpreadElementOper
                     ArrayObject* spreadArray = element.asObject()->asArrayObject();
                     ASSERT(spreadArray->isFastModeArray());
                     for (size_t spreadIndex = 0; spreadIndex < spreadArray->arrayLength(state); spreadIndex++) {
-                        arr->m_fastModeData[baseIndex + elementIndex] = spreadArray->m_fastModeData[spreadIndex];
+                        arr->setFastModeValue(baseIndex + elementIndex, spreadArray->getFastModeValue(spreadIndex));
                         elementIndex++;
                     }
                 } else {
-                    arr->m_fastModeData[baseIndex + elementIndex] = element;
+                    arr->setFastModeValue(baseIndex + elementIndex, element);
                     elementIndex++;
                 }
             } else {
@@ -3766,7 +3888,7 @@ NEVER_INLINE void ByteCodeInterpreter::arrayDefineOwnPropertyBySpreadElementOper
                     ASSERT(spreadArray->isFastModeArray());
                     Value spreadElement;
                     for (size_t spreadIndex = 0; spreadIndex < spreadArray->arrayLength(state); spreadIndex++) {
-                        spreadElement = spreadArray->m_fastModeData[spreadIndex];
+                        spreadElement = spreadArray->getFastModeValue(spreadIndex);
                         arr->defineOwnProperty(state, ObjectPropertyName(state, baseIndex + elementIndex), ObjectPropertyDescriptor(spreadElement, ObjectPropertyDescriptor::AllPresent));
                         elementIndex++;
                     }
@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2016-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#if defined(ENABLE_INTERPRETER_STATISTICS)
+
+#include "Escargot.h"
+#include "InterpreterStatistics.h"
+#include "parser/CodeBlock.h"
+#include "parser/Script.h"
+
+namespace Escargot {
+
+static const char* opcodeNames[OpcodeKindEnd] = {
+#define DECLARE_BYTECODE_NAME(name, pushCount, popCount) #name,
+    FOR_EACH_BYTECODE_OP(DECLARE_BYTECODE_NAME)
+#undef DECLARE_BYTECODE_NAME
+};
+
+InterpreterStatistics::InterpreterStatistics()
+{
+    reset();
+}
+
+InterpreterStatistics::BlockCounters* InterpreterStatistics::countersFor(ByteCodeBlock* block)
+{
+    auto iter = m_blockIndex.find(block);
+    if (LIKELY(iter != m_blockIndex.end())) {
+        return &m_blockCounters[iter->second];
+    }
+
+    m_blockIndex.insert(std::make_pair(block, m_blocks.size()));
+    m_blocks.pushBack(block);
+    m_blockCounters.push_back(BlockCounters({ 0, 0, std::map<size_t, InlineCacheCounters>() }));
+    return &m_blockCounters.back();
+}
+
+void InterpreterStatistics::reset()
+{
+    memset(m_opcodeCounts, 0, sizeof(m_opcodeCounts));
+    memset(m_slowCaseCounts, 0, sizeof(m_slowCaseCounts));
+    // counters of blocks are cleared in place because interpreter frames may hold them
+    for (auto& counters : m_blockCounters) {
+        counters.m_instructionCount = 0;
+        counters.m_slowCaseCount = 0;
+        counters.m_inlineCaches.clear();
+    }
+}
+
+static std::string functionDescription(ByteCodeBlock* block, size_t byteCodePosition = SIZE_MAX, bool resolvePosition = false)
+{
+    InterpretedCodeBlock* codeBlock = block->m_codeBlock;
+    std::string result = codeBlock->functionName().string()->toNonGCUTF8StringData();
+    if (result.empty()) {
+        result = codeBlock->isGlobalCodeBlock() ? "(program)" : "(anonymous)";
+    }
+
+    ExtendedNodeLOC loc = codeBlock->functionStart();
+    if (resolvePosition && codeBlock->script()) {
+        loc = block->computeNodeLOCFromByteCode(codeBlock->context(), byteCodePosition, codeBlock);
+    }
+
+    result += " (";
+    if (codeBlock->script()) {
+        result += codeBlock->script()->srcName()->toNonGCUTF8StringData();
+    }
+    result += ":" + std::to_string(loc.line) + ":" + std::to_string(loc.column) + ")";
+    if (byteCodePosition != SIZE_MAX && !resolvePosition) {
+        result += " @" + std::to_string(byteCodePosition);
+    }
+    return result;
+}
+
+bool InterpreterStatistics::dump(const char* path, bool resolveSitePositions)
+{
+    FILE* fp = path ? fopen(path, "w") : stdout;
+    if (!fp) {
+        return false;
+    }
+
+    size_t totalCount = 0;
+    std::vector<size_t> opcodes;
+    for (size_t i = 0; i < OpcodeKindEnd; i++) {
+        totalCount += m_opcodeCounts[i];
+        if (m_opcodeCounts[i] || m_slowCaseCounts[i]) {
+            opcodes.push_back(i);
+        }
+    }
+    std::sort(opcodes.begin(), opcodes.end(), [&](size_t a, size_t b) {
+        return m_opcodeCounts[a] > m_opcodeCounts[b];
+    });
+
+    fprintf(fp, "[opcodes] total %zu\n", totalCount);
+    fprintf(fp, "%14s %7s %14s  %s\n", "count", "ratio", "slow case", "opcode");
+    for (size_t i : opcodes) {
+        fprintf(fp, "%14zu %6.2f%% %14zu  %s\n", m_opcodeCounts[i], totalCount ? m_opcodeCounts[i] * 100.0 / totalCount : 0.0, m_slowCaseCounts[i], opcodeNames[i]);
+    }
+
+    std::vector<size_t> blocks;
+    for (size_t i = 0; i < m_blockCounters.size(); i++) {
+        if (m_blockCounters[i].m_instructionCount) {
+            blocks.push_back(i);
+        }
+    }
+    std::sort(blocks.begin(), blocks.end(), [&](size_t a, size_t b) {
+        return m_blockCounters[a].m_instructionCount > m_blockCounters[b].m_instructionCount;
+    });
+
+    fprintf(fp, "\n[byte code blocks]\n");
+    fprintf(fp, "%14s %14s %14s %14s  %s\n", "instructions", "slow case", "ic access", "ic miss", "function");
+    for (size_t i : blocks) {
+        const BlockCounters& counters = m_blockCounters[i];
+        size_t accessCount = 0;
+        size_t missCount = 0;
+        for (auto& site : counters.m_inlineCaches) {
+            accessCount += site.second.m_accessCount;
+            missCount += site.second.m_missCount;
+        }
+        fprintf(fp, "%14zu %14zu %14zu %14zu  %s\n", counters.m_instructionCount, counters.m_slowCaseCount,
+                accessCount, missCount, functionDescription(m_blocks[i]).data());
+    }
+
+    struct InlineCacheSite {
+        size_t m_blockIndex;
+        size_t m_byteCodePosition;
+        InlineCacheCounters m_counters;
+    };
+    std::vector<InlineCacheSite> sites;
+    for (size_t i = 0; i < m_blockCounters.size(); i++) {
+        for (auto& site : m_blockCounters[i].m_inlineCaches) {
+            if (site.second.m_missCount) {
+                sites.push_back(InlineCacheSite({ i, site.first, site.second }));
+            }
+        }
+    }
+    std::sort(sites.begin(), sites.end(), [](const InlineCacheSite& a, const InlineCacheSite& b) {
+        return a.m_counters.m_missCount > b.m_counters.m_missCount;
+    });
+
+    // sites without miss are omitted
+    fprintf(fp, "\n[inline cache sites]\n");
+    fprintf(fp, "%14s %14s %7s  %s\n", "access", "miss", "hit", "site");
+    for (const InlineCacheSite& site : sites) {
+        const InlineCacheCounters& counters = site.m_counters;
+        fprintf(fp, "%14zu %14zu %6.2f%%  %s\n", counters.m_accessCount, counters.m_missCount,
+                counters.m_accessCount > counters.m_missCount ? (counters.m_accessCount - counters.m_missCount) * 100.0 / counters.m_accessCount : 0.0,
+                functionDescription(m_blocks[site.m_blockIndex], site.m_byteCodePosition, resolveSitePositions).data());
+    }
+
+    if (path) {
+        fclose(fp);
+    } else {
+        fflush(fp);
+    }
+    return true;
+}
+} // namespace Escargot
+
+#endif
@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2016-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotInterpreterStatistics__
+#define __EscargotInterpreterStatistics__
+
+#if defined(ENABLE_INTERPRETER_STATISTICS)
+
+#include "interpreter/ByteCode.h"
+
+namespace Escargot {
+
+// counts executed opcodes, slow case entries and inline cache misses of interpreter
+// counted ByteCodeBlocks are kept alive to resolve positions of inline cache sites when dumping
+class InterpreterStatistics : public gc {
+public:
+    struct InlineCacheCounters {
+        size_t m_accessCount;
+        size_t m_missCount;
+    };
+
+    struct BlockCounters {
+        size_t m_instructionCount;
+        size_t m_slowCaseCount;
+        // keyed by position of byte code in ByteCodeBlock
+        std::map<size_t, InlineCacheCounters> m_inlineCaches;
+    };
+
+    InterpreterStatistics();
+
+    // looked up once per interpreter entry, not per instruction
+    BlockCounters* countersFor(ByteCodeBlock* block);
+
+    void countInstruction(BlockCounters* counters, Opcode opcode)
+    {
+        m_opcodeCounts[opcode]++;
+        counters->m_instructionCount++;
+    }
+
+    void countSlowCase(BlockCounters* counters, Opcode opcode)
+    {
+        m_slowCaseCounts[opcode]++;
+        counters->m_slowCaseCount++;
+    }
+
+    void countInlineCacheAccess(BlockCounters* counters, size_t byteCodePosition)
+    {
+        counters->m_inlineCaches[byteCodePosition].m_accessCount++;
+    }
+
+    void countInlineCacheMiss(BlockCounters* counters, size_t byteCodePosition)
+    {
+        counters->m_inlineCaches[byteCodePosition].m_missCount++;
+    }
+
+    void reset();
+
+    // write statistics as text into `path`. stdout is used if `path` is nullptr
+    // resolving line of inline cache site can regenerate byte code,
+    // so sites are printed with byte code position when `resolveSitePositions` is false
+    bool dump(const char* path, bool resolveSitePositions = true);
+
+private:
+    size_t m_opcodeCounts[OpcodeKindEnd];
+    size_t m_slowCaseCounts[OpcodeKindEnd];
+    // m_blocks[i] is counted into m_blockCounters[i]
+    Vector<ByteCodeBlock*, GCUtil::gc_malloc_allocator<ByteCodeBlock*>> m_blocks;
+    std::unordered_map<ByteCodeBlock*, size_t> m_blockIndex;
+    // deque keeps address of counters stable while new blocks are added
+    std::deque<BlockCounters> m_blockCounters;
+};
+} // namespace Escargot
+
+#endif
+
+#endif
@@ -35,6 +35,7 @@
 #include "runtime/ScriptAsyncFunctionObject.h"
 #include "runtime/ModuleNamespaceObject.h"
 #include "parser/ast/AST.h"
+#include "parser/Lexer.h"
 
 namespace Escargot {
 
@@ -48,12 +49,42 @@ void* Script::operator new(size_t size)
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(Script, m_sourceCode));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(Script, m_topCodeBlock));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(Script, m_moduleData));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(Script, m_lineStartIndex));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(Script));
         typeInited = true;
     }
     return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
 }
 
+void Script::buildLineStartIndex()
+{
+    ASSERT(!m_lineStartIndex.size());
+    m_lineStartIndex.pushBack(0);
+
+    const auto& data = m_sourceCode->bufferAccessData();
+    for (size_t i = 0; i < data.length; i++) {
+        char16_t c = data.charAt(i);
+        if (EscargotLexer::isLineTerminator(c)) {
+            // skip \r\n
+            if (c == 13 && (i + 1 < data.length) && data.charAt(i + 1) == 10) {
+                i++;
+            }
+            m_lineStartIndex.pushBack(i + 1);
+        }
+    }
+    m_lineStartIndex.shrinkToFit();
+}
+
+size_t Script::lineIndexOf(size_t sourceIndex)
+{
+    if (UNLIKELY(!m_lineStartIndex.size())) {
+        buildLineStartIndex();
+    }
+
+    auto iter = std::upper_bound(m_lineStartIndex.begin(), m_lineStartIndex.end(), sourceIndex);
+    return (iter - m_lineStartIndex.begin()) - 1;
+}
+
 bool Script::isExecuted()
 {
     if (isModule()) {
@@ -199,7 +199,16 @@ public:
     // https://tc39.es/ecma262/#sec-getmodulenamespace
     ModuleNamespaceObject* getModuleNamespace(ExecutionState& state);
 
+    // returns zero-based line number of sourceIndex in O(log n)
+    size_t lineIndexOf(size_t sourceIndex);
+    size_t lineStartIndex(size_t line)
+    {
+        ASSERT(line < m_lineStartIndex.size());
+        return m_lineStartIndex[line];
+    }
+
 private:
+    void buildLineStartIndex();
     Value executeLocal(ExecutionState& state, Value thisValue, InterpretedCodeBlock* parentCodeBlock, bool isStrictModeOutside = false, bool isEvalCodeOnFunction = false);
     Script* loadModuleFromScript(ExecutionState& state, String* src);
     void loadExternalModule(ExecutionState& state);
@@ -278,6 +287,8 @@ private:
     String* m_sourceCode;
     InterpretedCodeBlock* m_topCodeBlock;
     ModuleData* m_moduleData;
+    // start index of each line in m_sourceCode. built lazily on first location lookup
+    Vector<size_t, GCUtil::gc_malloc_atomic_allocator<size_t>> m_lineStartIndex;
 };
 } // namespace Escargot
 
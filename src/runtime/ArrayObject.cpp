@@ -34,6 +34,7 @@ ArrayObject::ArrayObject(ExecutionState& state)
 ArrayObject::ArrayObject(ExecutionState& state, Object* proto)
     : Object(state, proto, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER)
     , m_arrayLength(0)
+    , m_fastModeElementKind(ArrayObjectElementKind::Int32)
 #if !defined(ESCARGOT_64) || !defined(ESCARGOT_USE_32BIT_IN_64BIT)
     , m_fastModeData(nullptr)
 #endif
@@ -166,7 +167,7 @@ bool ArrayObject::defineOwnProperty(ExecutionState& state, const ObjectPropertyN
     if (LIKELY(isFastModeArray())) {
         if (LIKELY(idx != Value::InvalidIndexPropertyValue)) {
             uint32_t len = arrayLength(state);
-            if (len > idx && !m_fastModeData[idx].isEmpty()) {
+            if (len > idx && !getFastModeValue(idx).isEmpty()) {
                 // Non-empty slot of fast-mode array always has {writable:true, enumerable:true, configurable:true}.
                 // So, when new desciptor is not present, keep {w:true, e:true, c:true}
                 if (UNLIKELY(!(desc.isValuePresentAlone() || desc.isDataWritableEnumerableConfigurable()))) {
@@ -193,7 +194,7 @@ bool ArrayObject::defineOwnProperty(ExecutionState& state, const ObjectPropertyN
                     goto NonFastPath;
                 }
             }
-            m_fastModeData[idx] = desc.value();
+            setFastModeValue(idx, desc.value());
             return true;
         }
     }
@@ -228,8 +229,8 @@ bool ArrayObject::deleteOwnProperty(ExecutionState& state, const ObjectPropertyN
         if (LIKELY(idx != Value::InvalidIndexPropertyValue)) {
             uint32_t len = arrayLength(state);
             if (idx < len) {
-                if (!m_fastModeData[idx].isEmpty()) {
-                    m_fastModeData[idx] = Value(Value::EmptyValue);
+                if (!getFastModeValue(idx).isEmpty()) {
+                    setFastModeValue(idx, Value(Value::EmptyValue));
                     ensureRareData()->m_shouldUpdateEnumerateObject = true;
                 }
                 return true;
@@ -246,7 +247,7 @@ void ArrayObject::enumeration(ExecutionState& state, bool (*callback)(ExecutionS
         size_t len = arrayLength(state);
         for (size_t i = 0; i < len; i++) {
             ASSERT(isFastModeArray());
-            if (m_fastModeData[i].isEmpty())
+            if (getFastModeValue(i).isEmpty())
                 continue;
             if (!callback(state, this, ObjectPropertyName(state, Value(i)), ObjectStructurePropertyDescriptor::createDataDescriptor(ObjectStructurePropertyDescriptor::AllPresent), data)) {
                 return;
@@ -272,7 +273,7 @@ void ArrayObject::sort(ExecutionState& state, int64_t length, const std::functio
             Value* tempBuffer = canUseStack ? (Value*)alloca(byteLength) : CustomAllocator<Value>().allocate(orgLength);
 
             for (size_t i = 0; i < orgLength; i++) {
-                tempBuffer[i] = m_fastModeData[i];
+                tempBuffer[i] = getFastModeValue(i);
             }
 
             if (orgLength) {
@@ -294,7 +295,7 @@ void ArrayObject::sort(ExecutionState& state, int64_t length, const std::functio
 
             if (isFastModeArray()) {
                 for (size_t i = 0; i < orgLength; i++) {
-                    m_fastModeData[i] = tempBuffer[i];
+                    setFastModeValue(i, tempBuffer[i]);
                 }
             }
 
@@ -328,11 +329,22 @@ void ArrayObject::convertIntoNonFastMode(ExecutionState& state)
 
     auto length = arrayLength(state);
     for (size_t i = 0; i < length; i++) {
-        if (!m_fastModeData[i].isEmpty()) {
-            defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(i)), ObjectPropertyDescriptor(m_fastModeData[i], ObjectPropertyDescriptor::AllPresent));
+        Value v = getFastModeValue(i);
+        if (!v.isEmpty()) {
+            defineOwnPropertyThrowsException(state, ObjectPropertyName(state, Value(i)), ObjectPropertyDescriptor(v, ObjectPropertyDescriptor::AllPresent));
         }
     }
 
+    if (m_fastModeElementKind != ArrayObjectElementKind::Generic) {
+        void*& unboxedData = fastModeUnboxedData();
+        if (unboxedData) {
+            GC_FREE(unboxedData);
+            unboxedData = nullptr;
+        }
+        m_fastModeElementKind = ArrayObjectElementKind::Generic;
+        return;
+    }
+
 #if defined(ESCARGOT_64) && defined(ESCARGOT_USE_32BIT_IN_64BIT)
     m_fastModeData.resizeWithUninitializedValues(length, 0);
 #else
@@ -341,6 +353,168 @@ void ArrayObject::convertIntoNonFastMode(ExecutionState& state)
 #endif
 }
 
+void ArrayObject::setFastModeValueWithElementKindTransition(size_t idx, const Value& v)
+{
+    ASSERT(m_fastModeElementKind != ArrayObjectElementKind::Generic);
+    if (v.isNumber()) {
+        if (m_fastModeElementKind == ArrayObjectElementKind::Int32) {
+            convertFastModeElementKindIntoDouble();
+        }
+        double d = v.asNumber();
+        if (UNLIKELY(std::isnan(d))) {
+            // canonicalize NaN to avoid confusion with hole
+            d = std::numeric_limits<double>::quiet_NaN();
+        }
+        fastModeDoubleData()[idx] = d;
+    } else {
+        convertFastModeElementKindIntoGeneric();
+        m_fastModeData[idx] = v;
+    }
+}
+
+size_t ArrayObject::fastModeBufferCapacity()
+{
+    if (hasRareData() && rareData()->m_arrayObjectFastModeBufferCapacity) {
+        return rareData()->m_arrayObjectFastModeBufferCapacity;
+    }
+    return m_arrayLength;
+}
+
+void ArrayObject::convertFastModeElementKindIntoDouble()
+{
+    ASSERT(m_fastModeElementKind == ArrayObjectElementKind::Int32);
+
+    size_t length = m_arrayLength;
+    size_t capacity = fastModeBufferCapacity();
+    int32_t* int32Data = fastModeInt32Data();
+    m_fastModeElementKind = ArrayObjectElementKind::Double;
+
+    if (!capacity) {
+        ASSERT(!int32Data);
+        return;
+    }
+
+    double* doubleData = (double*)GC_MALLOC_ATOMIC(sizeof(double) * capacity);
+    for (size_t i = 0; i < length; i++) {
+        if (int32Data[i] == s_unboxedInt32Hole) {
+            setUnboxedHole(doubleData[i]);
+        } else {
+            doubleData[i] = int32Data[i];
+        }
+    }
+    fastModeUnboxedData() = doubleData;
+
+    GC_FREE(int32Data);
+}
+
+void ArrayObject::convertFastModeElementKindIntoGeneric()
+{
+    ASSERT(m_fastModeElementKind != ArrayObjectElementKind::Generic);
+
+    size_t length = m_arrayLength;
+    size_t capacity = fastModeBufferCapacity();
+
+    // read elements before the slot is reused by generic storage
+    void* unboxedData = fastModeUnboxedData();
+    bool isInt32Kind = m_fastModeElementKind == ArrayObjectElementKind::Int32;
+    fastModeUnboxedData() = nullptr;
+    m_fastModeElementKind = ArrayObjectElementKind::Generic;
+
+    if (!capacity) {
+        ASSERT(!unboxedData);
+        return;
+    }
+
+#if defined(ESCARGOT_64) && defined(ESCARGOT_USE_32BIT_IN_64BIT)
+    m_fastModeData.resizeWithUninitializedValues(0, capacity);
+#else
+    m_fastModeData = (EncodedValue*)GC_MALLOC(sizeof(EncodedValue) * capacity);
+#endif
+
+    for (size_t i = 0; i < length; i++) {
+        if (isInt32Kind) {
+            int32_t v = reinterpret_cast<int32_t*>(unboxedData)[i];
+            m_fastModeData[i] = v == s_unboxedInt32Hole ? Value(Value::EmptyValue) : Value(v);
+        } else {
+            const double& v = reinterpret_cast<double*>(unboxedData)[i];
+            m_fastModeData[i] = isUnboxedHole(v) ? Value(Value::EmptyValue) : Value(v);
+        }
+    }
+
+    GC_FREE(unboxedData);
+}
+
+void ArrayObject::fillFastModeUnboxedHoles(size_t start, size_t end)
+{
+    if (m_fastModeElementKind == ArrayObjectElementKind::Int32) {
+        int32_t* int32Data = fastModeInt32Data();
+        for (size_t i = start; i < end; i++) {
+            int32Data[i] = s_unboxedInt32Hole;
+        }
+    } else {
+        double* doubleData = fastModeDoubleData();
+        for (size_t i = start; i < end; i++) {
+            setUnboxedHole(doubleData[i]);
+        }
+    }
+}
+
+void ArrayObject::resizeFastModeUnboxedData(size_t oldLength, size_t newLength, bool useFitStorage)
+{
+    ASSERT(m_fastModeElementKind != ArrayObjectElementKind::Generic);
+    void*& unboxedData = fastModeUnboxedData();
+    const size_t elementSize = fastModeUnboxedElementSize();
+    bool hasRD = hasRareData();
+
+    if (useFitStorage || oldLength == 0 || newLength <= 128) {
+        if (newLength) {
+            // GC_REALLOC keeps kind of block. so we should allocate atomic block first
+            if (unboxedData) {
+                unboxedData = GC_REALLOC(unboxedData, elementSize * newLength);
+            } else {
+                unboxedData = GC_MALLOC_ATOMIC(elementSize * newLength);
+            }
+        } else if (unboxedData) {
+            GC_FREE(unboxedData);
+            unboxedData = nullptr;
+        }
+        if (hasRD) {
+            rareData()->m_arrayObjectFastModeBufferCapacity = 0;
+        }
+    } else {
+        ASSERT(newLength > 128);
+
+        const size_t minExpandCountForUsingLog2Function = 3;
+        size_t oldCapacity = hasRD ? (size_t)rareData()->m_arrayObjectFastModeBufferCapacity : oldLength;
+        auto rd = ensureRareData();
+        if (newLength > oldCapacity) {
+            size_t newCapacity;
+            if (rd->m_arrayObjectFastModeBufferExpandCount >= minExpandCountForUsingLog2Function) {
+                ComputeReservedCapacityFunctionWithLog2<> f;
+                newCapacity = f(newLength);
+            } else {
+                ComputeReservedCapacityFunctionWithPercent<130> f;
+                newCapacity = f(newLength);
+            }
+            void* newUnboxedData = GC_MALLOC_ATOMIC(elementSize * newCapacity);
+            if (unboxedData) {
+                memcpy(newUnboxedData, unboxedData, elementSize * oldLength);
+                GC_FREE(unboxedData);
+            }
+            unboxedData = newUnboxedData;
+
+            rd->m_arrayObjectFastModeBufferCapacity = newCapacity;
+            if (rd->m_arrayObjectFastModeBufferExpandCount < minExpandCountForUsingLog2Function) {
+                rd->m_arrayObjectFastModeBufferExpandCount++;
+            }
+        } else {
+            rd->m_arrayObjectFastModeBufferCapacity = oldCapacity;
+        }
+    }
+
+    fillFastModeUnboxedHoles(oldLength, newLength);
+}
+
 bool ArrayObject::setArrayLength(ExecutionState& state, const Value& newLength)
 {
     bool isPrimitiveValue;
@@ -381,7 +555,9 @@ bool ArrayObject::setArrayLength(ExecutionState& state, const uint32_t newLength
         auto oldLength = arrayLength(state);
         if (LIKELY(oldLength != newLength)) {
             m_arrayLength = newLength;
-            if (useFitStorage || oldLength == 0 || newLength <= 128) {
+            if (m_fastModeElementKind != ArrayObjectElementKind::Generic) {
+                resizeFastModeUnboxedData(oldLength, newLength, useFitStorage);
+            } else if (useFitStorage || oldLength == 0 || newLength <= 128) {
                 bool hasRD = hasRareData();
 #if defined(ESCARGOT_64) && defined(ESCARGOT_USE_32BIT_IN_64BIT)
                 m_fastModeData.resizeWithUninitializedValues(oldLength, newLength);
@@ -523,7 +699,7 @@ ObjectGetResult ArrayObject::getVirtualValue(ExecutionState& state, const Object
     if (LIKELY(isFastModeArray())) {
         uint32_t idx = P.tryToUseAsIndexProperty();
         if (LIKELY(idx != Value::InvalidIndexPropertyValue) && LIKELY(idx < arrayLength(state))) {
-            Value v = m_fastModeData[idx];
+            Value v = getFastModeValue(idx);
             if (LIKELY(!v.isEmpty())) {
                 return ObjectGetResult(v, true, true, true);
             }
@@ -538,7 +714,7 @@ ObjectHasPropertyResult ArrayObject::hasIndexedProperty(ExecutionState& state, c
     if (LIKELY(isFastModeArray())) {
         uint32_t idx = propertyName.tryToUseAsIndexProperty(state);
         if (LIKELY(idx != Value::InvalidIndexPropertyValue) && LIKELY(idx < arrayLength(state))) {
-            Value v = m_fastModeData[idx];
+            Value v = getFastModeValue(idx);
             if (LIKELY(!v.isEmpty())) {
                 return ObjectHasPropertyResult(ObjectGetResult(v, true, true, true));
             }
@@ -552,7 +728,7 @@ ObjectGetResult ArrayObject::getIndexedProperty(ExecutionState& state, const Val
     if (LIKELY(isFastModeArray())) {
         uint32_t idx = property.tryToUseAsIndexProperty(state);
         if (LIKELY(idx != Value::InvalidIndexPropertyValue) && LIKELY(idx < arrayLength(state))) {
-            Value v = m_fastModeData[idx];
+            Value v = getFastModeValue(idx);
             if (LIKELY(!v.isEmpty())) {
                 return ObjectGetResult(v, true, true, true);
             }
@@ -577,11 +753,11 @@ bool ArrayObject::setIndexedProperty(ExecutionState& state, const Value& propert
                 }
                 // fast, non-fast mode can be changed while changing length
                 if (LIKELY(isFastModeArray())) {
-                    m_fastModeData[idx] = value;
+                    setFastModeValue(idx, value);
                     return true;
                 }
             } else {
-                m_fastModeData[idx] = value;
+                setFastModeValue(idx, value);
                 return true;
             }
         }
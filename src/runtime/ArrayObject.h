@@ -31,12 +31,23 @@ namespace Escargot {
 
 class ArrayIteratorObject;
 
+// Element kind of fast-mode ArrayObject
+// Int32 and Double kind store elements as unboxed double in a pointer-free buffer
+// so numeric arrays need no heap-allocated double and are not scanned by GC
+// kind only moves forward (Int32 -> Double -> Generic)
+enum class ArrayObjectElementKind : uint8_t {
+    Int32, // every element is int32 value or hole. stored as int32_t
+    Double, // every element is number value or hole. stored as double
+    Generic, // elements are stored as encoded value
+};
+
 class ArrayObject : public Object {
     friend class VMInstance;
     friend class Global;
     friend class ByteCodeInterpreter;
     friend class EnumerateObjectWithDestruction;
     friend class EnumerateObjectWithIteration;
+    friend class HeapSnapshot;
     friend Value builtinArrayConstructor(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget);
     friend void initializeCustomAllocators();
     friend int getValidValueInArrayObject(void* ptr, GC_mark_custom_result* arr);
@@ -89,10 +100,73 @@ public:
         }
     }
 
+    // direct access to fast-mode storage
+    // caller should check isFastModeArray() and index range again after calling any user code
+    // because user code can shrink the array or convert it into non-fast mode
+    ALWAYS_INLINE bool isFastModeArray()
+    {
+        if (UNLIKELY(hasRareData())) {
+            return rareData()->m_isFastModeArrayObject;
+        }
+        return true;
+    }
+
+    bool isLengthPropertyWritable()
+    {
+        return hasRareData() ? rareData()->m_isArrayObjectLengthWritable : true;
+    }
+
+    ALWAYS_INLINE uint32_t arrayLength(ExecutionState&)
+    {
+        return m_arrayLength;
+    }
+
+    // returns EmptyValue for hole
+    ALWAYS_INLINE Value getFastModeValue(size_t idx)
+    {
+        if (LIKELY(m_fastModeElementKind == ArrayObjectElementKind::Generic)) {
+            return m_fastModeData[idx];
+        }
+        if (m_fastModeElementKind == ArrayObjectElementKind::Int32) {
+            int32_t slot = fastModeInt32Data()[idx];
+            if (UNLIKELY(slot == s_unboxedInt32Hole)) {
+                return Value(Value::EmptyValue);
+            }
+            return Value(slot);
+        }
+        const double& slot = fastModeDoubleData()[idx];
+        if (UNLIKELY(isUnboxedHole(slot))) {
+            return Value(Value::EmptyValue);
+        }
+        return Value(slot);
+    }
+
+    ALWAYS_INLINE void setFastModeValue(size_t idx, const Value& v)
+    {
+        if (LIKELY(m_fastModeElementKind == ArrayObjectElementKind::Generic)) {
+            m_fastModeData[idx] = v;
+        } else if (m_fastModeElementKind == ArrayObjectElementKind::Int32) {
+            if (LIKELY(v.isInt32() && v.asInt32() != s_unboxedInt32Hole)) {
+                fastModeInt32Data()[idx] = v.asInt32();
+            } else if (v.isEmpty()) {
+                fastModeInt32Data()[idx] = s_unboxedInt32Hole;
+            } else {
+                setFastModeValueWithElementKindTransition(idx, v);
+            }
+        } else if (LIKELY(v.isNumber() && !std::isnan(v.asNumber()))) {
+            fastModeDoubleData()[idx] = v.asNumber();
+        } else if (v.isEmpty()) {
+            setUnboxedHole(fastModeDoubleData()[idx]);
+        } else {
+            setFastModeValueWithElementKindTransition(idx, v);
+        }
+    }
+
 protected:
     ArrayObject()
         : Object()
         , m_arrayLength(0)
+        , m_fastModeElementKind(ArrayObjectElementKind::Int32)
 #if !defined(ESCARGOT_64) || !defined(ESCARGOT_USE_32BIT_IN_64BIT)
         , m_fastModeData(nullptr)
 #endif
@@ -102,31 +176,71 @@ protected:
     }
 
 private:
-    ALWAYS_INLINE bool isFastModeArray()
+    void setFastModeArrayValueWithoutExpanding(ExecutionState& state, size_t idx, const Value& v)
     {
-        if (UNLIKELY(hasRareData())) {
-            return rareData()->m_isFastModeArrayObject;
-        }
-        return true;
+        ASSERT(isFastModeArray());
+        ASSERT(idx < arrayLength(state));
+        setFastModeValue(idx, v);
     }
 
-    bool isLengthPropertyWritable()
+    ArrayObjectElementKind fastModeElementKind() const
     {
-        return hasRareData() ? rareData()->m_isArrayObjectLengthWritable : true;
+        return m_fastModeElementKind;
     }
 
-    void setFastModeArrayValueWithoutExpanding(ExecutionState& state, size_t idx, const Value& v)
+    // hole of unboxed int32 buffer is INT32_MIN. storing INT32_MIN itself moves the array into Double kind
+    static constexpr int32_t s_unboxedInt32Hole = std::numeric_limits<int32_t>::min();
+
+    // hole of unboxed double buffer is represented by signaling NaN with special payload
+    // every NaN is canonicalized into quiet NaN before stored, so it cannot be confused with element value
+    // we should access hole by bits (loading signaling NaN through x87 FPU makes it quiet NaN)
+    static constexpr uint64_t s_unboxedHoleBits = 0x7FF4DEADBEEF0000ULL;
+
+    static ALWAYS_INLINE bool isUnboxedHole(const double& slot)
     {
-        ASSERT(isFastModeArray());
-        ASSERT(idx < arrayLength(state));
-        m_fastModeData[idx] = v;
+        uint64_t bits;
+        memcpy(&bits, &slot, sizeof(double));
+        return bits == s_unboxedHoleBits;
     }
 
-    ALWAYS_INLINE uint32_t arrayLength(ExecutionState&)
+    static ALWAYS_INLINE void setUnboxedHole(double& slot)
     {
-        return m_arrayLength;
+        uint64_t bits = s_unboxedHoleBits;
+        memcpy(&slot, &bits, sizeof(double));
+    }
+
+    // unboxed int32 or double buffer shares the slot of m_fastModeData
+    // GC marks the slot as a pointer, and the buffer itself is allocated as atomic(pointer-free) block
+    ALWAYS_INLINE void*& fastModeUnboxedData()
+    {
+        ASSERT(m_fastModeElementKind != ArrayObjectElementKind::Generic);
+        return *reinterpret_cast<void**>(&m_fastModeData);
+    }
+
+    ALWAYS_INLINE int32_t* fastModeInt32Data()
+    {
+        ASSERT(m_fastModeElementKind == ArrayObjectElementKind::Int32);
+        return reinterpret_cast<int32_t*>(fastModeUnboxedData());
     }
 
+    ALWAYS_INLINE double* fastModeDoubleData()
+    {
+        ASSERT(m_fastModeElementKind == ArrayObjectElementKind::Double);
+        return reinterpret_cast<double*>(fastModeUnboxedData());
+    }
+
+    size_t fastModeUnboxedElementSize() const
+    {
+        return m_fastModeElementKind == ArrayObjectElementKind::Int32 ? sizeof(int32_t) : sizeof(double);
+    }
+
+    size_t fastModeBufferCapacity();
+    void setFastModeValueWithElementKindTransition(size_t idx, const Value& v);
+    void convertFastModeElementKindIntoDouble();
+    void convertFastModeElementKindIntoGeneric();
+    void fillFastModeUnboxedHoles(size_t start, size_t end);
+    void resizeFastModeUnboxedData(size_t oldLength, size_t newLength, bool useFitStorage);
+
     bool setArrayLength(ExecutionState& state, const Value& newLength);
     bool setArrayLength(ExecutionState& state, const uint32_t newLength, bool useFitStorage = false, bool considerHole = true);
     void convertIntoNonFastMode(ExecutionState& state);
@@ -134,6 +248,7 @@ private:
     ObjectGetResult getVirtualValue(ExecutionState& state, const ObjectPropertyName& P);
 
     uint32_t m_arrayLength;
+    ArrayObjectElementKind m_fastModeElementKind;
 #if defined(ESCARGOT_64) && defined(ESCARGOT_USE_32BIT_IN_64BIT)
     TightVectorWithNoSize<EncodedSmallValue, CustomAllocator<EncodedSmallValue>> m_fastModeData;
 #else
@@ -21,6 +21,7 @@
 #include "BigInt.h"
 #include "ThreadLocal.h"
 #include "ErrorObject.h"
+#include "CheckedArithmetic.h"
 
 namespace Escargot {
 
@@ -110,22 +111,22 @@ void BigIntData::init(const char* buf, size_t length, int radix)
 
 bool BigIntData::lessThan(BigInt* b) const
 {
-    return bf_cmp_lt(&m_data, &b->m_bf);
+    return bf_cmp_lt(&m_data, b->bf());
 }
 
 bool BigIntData::lessThanEqual(BigInt* b) const
 {
-    return bf_cmp_le(&m_data, &b->m_bf);
+    return bf_cmp_le(&m_data, b->bf());
 }
 
 bool BigIntData::greaterThan(BigInt* b) const
 {
-    return bf_cmp(&m_data, &b->m_bf) > 0;
+    return bf_cmp(&m_data, b->bf()) > 0;
 }
 
 bool BigIntData::greaterThanEqual(BigInt* b) const
 {
-    return bf_cmp(&m_data, &b->m_bf) >= 0;
+    return bf_cmp(&m_data, b->bf()) >= 0;
 }
 
 bool BigIntData::isNaN()
@@ -154,6 +155,9 @@ void BigInt::initFinalizer()
 
 BigInt::BigInt()
     : m_tag(POINTER_VALUE_BIGINT_TAG_IN_DATA)
+    , m_hasSmallValue(false)
+    , m_hasBF(true)
+    , m_smallValue(0)
 {
     bf_init(ThreadLocal::bfContext(), &m_bf);
     initFinalizer();
@@ -172,23 +176,39 @@ static void setBigInt(bf_t* bf, uint64_t num)
     }
 }
 
-BigInt::BigInt(int64_t num)
-    : BigInt()
+static void setBigInt(bf_t* bf, int64_t num)
 {
     int sign = num < 0;
+    // negate in unsigned type to handle INT64_MIN
+    setBigInt(bf, sign ? -static_cast<uint64_t>(num) : static_cast<uint64_t>(num));
     if (sign) {
-        num = -num;
-    }
-    setBigInt(&m_bf, num);
-    if (sign) {
-        m_bf.sign = 1;
+        bf->sign = 1;
     }
 }
 
+BigInt::BigInt(int64_t num)
+    : m_tag(POINTER_VALUE_BIGINT_TAG_IN_DATA)
+    , m_hasSmallValue(true)
+    , m_hasBF(false)
+    , m_smallValue(num)
+{
+}
+
 BigInt::BigInt(uint64_t num)
-    : BigInt()
+    : m_tag(POINTER_VALUE_BIGINT_TAG_IN_DATA)
+    , m_hasSmallValue(false)
+    , m_hasBF(false)
+    , m_smallValue(0)
 {
-    setBigInt(&m_bf, num);
+    if (LIKELY(num <= static_cast<uint64_t>(std::numeric_limits<int64_t>::max()))) {
+        m_hasSmallValue = true;
+        m_smallValue = static_cast<int64_t>(num);
+    } else {
+        bf_init(ThreadLocal::bfContext(), &m_bf);
+        setBigInt(&m_bf, num);
+        m_hasBF = true;
+        initFinalizer();
+    }
 }
 
 BigInt::BigInt(BigIntData&& n)
@@ -196,13 +216,38 @@ BigInt::BigInt(BigIntData&& n)
 {
     bf_move(&m_bf, &n.m_data);
     bf_init(m_bf.ctx, &n.m_data);
+    initSmallValueFromBF();
 }
 
 BigInt::BigInt(bf_t bf)
     : m_tag(POINTER_VALUE_BIGINT_TAG_IN_DATA)
+    , m_hasSmallValue(false)
+    , m_hasBF(true)
+    , m_smallValue(0)
     , m_bf(bf)
 {
     initFinalizer();
+    initSmallValueFromBF();
+}
+
+void BigInt::initBFFromSmallValue()
+{
+    ASSERT(m_hasSmallValue && !m_hasBF);
+    bf_init(ThreadLocal::bfContext(), &m_bf);
+    setBigInt(&m_bf, m_smallValue);
+    m_hasBF = true;
+    initFinalizer();
+}
+
+void BigInt::initSmallValueFromBF()
+{
+    ASSERT(m_hasBF);
+    int64_t v;
+    // bf_get_int64 fails on NaN or out of range value
+    if (bf_is_finite(&m_bf) && bf_get_int64(&v, &m_bf, 0) == 0) {
+        m_hasSmallValue = true;
+        m_smallValue = v;
+    }
 }
 
 Optional<BigInt*> BigInt::parseString(const char* buf, size_t length, int radix)
@@ -253,6 +298,23 @@ void BigInt::throwBFException(ExecutionState& state, int status)
 
 String* BigInt::toString(int radix)
 {
+    if (m_hasSmallValue) {
+        ASSERT(radix >= 2 && radix <= 36);
+        // 64 digits for radix 2 and sign
+        char buffer[66];
+        char* end = buffer + sizeof(buffer);
+        char* p = end;
+        uint64_t v = m_smallValue < 0 ? -static_cast<uint64_t>(m_smallValue) : static_cast<uint64_t>(m_smallValue);
+        do {
+            *--p = "0123456789abcdefghijklmnopqrstuvwxyz"[v % radix];
+            v /= radix;
+        } while (v);
+        if (m_smallValue < 0) {
+            *--p = '-';
+        }
+        return String::fromASCII(p, end - p);
+    }
+
     int savedSign = m_bf.sign;
     if (m_bf.expn == BF_EXP_ZERO) {
         m_bf.sign = 0;
@@ -273,6 +335,9 @@ String* BigInt::toString(int radix)
 
 double BigInt::toNumber() const
 {
+    if (m_hasSmallValue) {
+        return static_cast<double>(m_smallValue);
+    }
     double d;
     bf_get_float64(&m_bf, &d, BF_RNDN);
     return d;
@@ -280,6 +345,9 @@ double BigInt::toNumber() const
 
 int64_t BigInt::toInt64() const
 {
+    if (m_hasSmallValue) {
+        return m_smallValue;
+    }
     int64_t d;
     bf_get_int64(&d, &m_bf, BF_GET_INT_MOD);
     return d;
@@ -287,6 +355,9 @@ int64_t BigInt::toInt64() const
 
 uint64_t BigInt::toUint64() const
 {
+    if (m_hasSmallValue) {
+        return static_cast<uint64_t>(m_smallValue);
+    }
     uint64_t d;
     bf_get_uint64(&d, &m_bf, BF_GET_INT_MOD);
     return d;
@@ -295,12 +366,15 @@ uint64_t BigInt::toUint64() const
 
 bool BigInt::equals(BigInt* b)
 {
-    return bf_cmp_eq(&m_bf, &b->m_bf);
+    if (m_hasSmallValue && b->m_hasSmallValue) {
+        return m_smallValue == b->m_smallValue;
+    }
+    return bf_cmp_eq(bf(), b->bf());
 }
 
 bool BigInt::equals(const BigIntData& b)
 {
-    return bf_cmp_eq(&m_bf, &b.m_data);
+    return bf_cmp_eq(bf(), &b.m_data);
 }
 
 bool BigInt::equals(String* s)
@@ -317,49 +391,66 @@ bool BigInt::equals(double b)
 
 bool BigInt::lessThan(const BigIntData& b)
 {
-    return bf_cmp_lt(&m_bf, &b.m_data);
+    return bf_cmp_lt(bf(), &b.m_data);
 }
 
 bool BigInt::lessThanEqual(const BigIntData& b)
 {
-    return bf_cmp_le(&m_bf, &b.m_data);
+    return bf_cmp_le(bf(), &b.m_data);
 }
 
 bool BigInt::greaterThan(const BigIntData& b)
 {
-    return bf_cmp(&m_bf, &b.m_data) > 0;
+    return bf_cmp(bf(), &b.m_data) > 0;
 }
 
 bool BigInt::greaterThanEqual(const BigIntData& b)
 {
-    return bf_cmp(&m_bf, &b.m_data) >= 0;
+    return bf_cmp(bf(), &b.m_data) >= 0;
 }
 
 bool BigInt::lessThan(BigInt* b)
 {
-    return bf_cmp_lt(&m_bf, &b->m_bf);
+    if (m_hasSmallValue && b->m_hasSmallValue) {
+        return m_smallValue < b->m_smallValue;
+    }
+    return bf_cmp_lt(bf(), b->bf());
 }
 
 bool BigInt::lessThanEqual(BigInt* b)
 {
-    return bf_cmp_le(&m_bf, &b->m_bf);
+    if (m_hasSmallValue && b->m_hasSmallValue) {
+        return m_smallValue <= b->m_smallValue;
+    }
+    return bf_cmp_le(bf(), b->bf());
 }
 
 bool BigInt::greaterThan(BigInt* b)
 {
-    return bf_cmp(&m_bf, &b->m_bf) > 0;
+    if (m_hasSmallValue && b->m_hasSmallValue) {
+        return m_smallValue > b->m_smallValue;
+    }
+    return bf_cmp(bf(), b->bf()) > 0;
 }
 
 bool BigInt::greaterThanEqual(BigInt* b)
 {
-    return bf_cmp(&m_bf, &b->m_bf) >= 0;
+    if (m_hasSmallValue && b->m_hasSmallValue) {
+        return m_smallValue >= b->m_smallValue;
+    }
+    return bf_cmp(bf(), b->bf()) >= 0;
 }
 
 BigInt* BigInt::addition(ExecutionState& state, BigInt* b)
 {
+    int64_t result;
+    if (m_hasSmallValue && b->m_hasSmallValue && ArithmeticOperations<int64_t, int64_t, int64_t>::add(m_smallValue, b->m_smallValue, result)) {
+        return new BigInt(result);
+    }
+
     bf_t r;
     bf_init(ThreadLocal::bfContext(), &r);
-    int ret = bf_add(&r, &m_bf, &b->m_bf, BF_PREC_INF, BF_RNDZ);
+    int ret = bf_add(&r, bf(), b->bf(), BF_PREC_INF, BF_RNDZ);
     if (UNLIKELY(ret)) {
         bf_delete(&r);
         throwBFException(state, ret);
@@ -369,9 +460,14 @@ BigInt* BigInt::addition(ExecutionState& state, BigInt* b)
 
 BigInt* BigInt::subtraction(ExecutionState& state, BigInt* b)
 {
+    int64_t result;
+    if (m_hasSmallValue && b->m_hasSmallValue && ArithmeticOperations<int64_t, int64_t, int64_t>::sub(m_smallValue, b->m_smallValue, result)) {
+        return new BigInt(result);
+    }
+
     bf_t r;
     bf_init(ThreadLocal::bfContext(), &r);
-    int ret = bf_sub(&r, &m_bf, &b->m_bf, BF_PREC_INF, BF_RNDZ);
+    int ret = bf_sub(&r, bf(), b->bf(), BF_PREC_INF, BF_RNDZ);
     if (UNLIKELY(ret)) {
         bf_delete(&r);
         throwBFException(state, ret);
@@ -381,9 +477,14 @@ BigInt* BigInt::subtraction(ExecutionState& state, BigInt* b)
 
 BigInt* BigInt::multiply(ExecutionState& state, BigInt* b)
 {
+    int64_t result;
+    if (m_hasSmallValue && b->m_hasSmallValue && ArithmeticOperations<int64_t, int64_t, int64_t>::multiply(m_smallValue, b->m_smallValue, result)) {
+        return new BigInt(result);
+    }
+
     bf_t r;
     bf_init(ThreadLocal::bfContext(), &r);
-    int ret = bf_mul(&r, &m_bf, &b->m_bf, BF_PREC_INF, BF_RNDZ);
+    int ret = bf_mul(&r, bf(), b->bf(), BF_PREC_INF, BF_RNDZ);
     if (UNLIKELY(ret)) {
         bf_delete(&r);
         throwBFException(state, ret);
@@ -391,12 +492,23 @@ BigInt* BigInt::multiply(ExecutionState& state, BigInt* b)
     return new BigInt(r);
 }
 
+// division by zero and INT64_MIN / -1 are handled by libbf
+static bool canDivideSmallValue(int64_t a, int64_t b)
+{
+    return b != 0 && !(a == std::numeric_limits<int64_t>::min() && b == -1);
+}
+
 BigInt* BigInt::division(ExecutionState& state, BigInt* b)
 {
+    if (m_hasSmallValue && b->m_hasSmallValue && canDivideSmallValue(m_smallValue, b->m_smallValue)) {
+        // integer division of C++ truncates toward zero
+        return new BigInt(static_cast<int64_t>(m_smallValue / b->m_smallValue));
+    }
+
     bf_t r, rem;
     bf_init(ThreadLocal::bfContext(), &r);
     bf_init(ThreadLocal::bfContext(), &rem);
-    int ret = bf_divrem(&r, &rem, &m_bf, &b->m_bf, BF_PREC_INF, BF_RNDZ,
+    int ret = bf_divrem(&r, &rem, bf(), b->bf(), BF_PREC_INF, BF_RNDZ,
                         BF_RNDZ);
     bf_delete(&rem);
     if (UNLIKELY(ret)) {
@@ -408,9 +520,14 @@ BigInt* BigInt::division(ExecutionState& state, BigInt* b)
 
 BigInt* BigInt::remainder(ExecutionState& state, BigInt* b)
 {
+    if (m_hasSmallValue && b->m_hasSmallValue && canDivideSmallValue(m_smallValue, b->m_smallValue)) {
+        // sign of result follows dividend
+        return new BigInt(static_cast<int64_t>(m_smallValue % b->m_smallValue));
+    }
+
     bf_t r;
     bf_init(ThreadLocal::bfContext(), &r);
-    int ret = bf_rem(&r, &m_bf, &b->m_bf, BF_PREC_INF, BF_RNDZ,
+    int ret = bf_rem(&r, bf(), b->bf(), BF_PREC_INF, BF_RNDZ,
                      BF_RNDZ)
         & BF_ST_INVALID_OP;
     if (UNLIKELY(ret)) {
@@ -422,9 +539,28 @@ BigInt* BigInt::remainder(ExecutionState& state, BigInt* b)
 
 BigInt* BigInt::pow(ExecutionState& state, BigInt* b)
 {
+    if (m_hasSmallValue && b->m_hasSmallValue && b->m_smallValue >= 0) {
+        int64_t base = m_smallValue;
+        int64_t exponent = b->m_smallValue;
+        int64_t result = 1;
+        bool overflow = false;
+        while (exponent && !overflow) {
+            if (exponent & 1) {
+                overflow = !ArithmeticOperations<int64_t, int64_t, int64_t>::multiply(result, base, result);
+            }
+            exponent >>= 1;
+            if (exponent && !overflow) {
+                overflow = !ArithmeticOperations<int64_t, int64_t, int64_t>::multiply(base, base, base);
+            }
+        }
+        if (!overflow) {
+            return new BigInt(result);
+        }
+    }
+
     bf_t r;
     bf_init(ThreadLocal::bfContext(), &r);
-    int ret = bf_pow(&r, &m_bf, &b->m_bf, BF_PREC_INF, BF_RNDZ);
+    int ret = bf_pow(&r, bf(), b->bf(), BF_PREC_INF, BF_RNDZ);
     if (UNLIKELY(ret)) {
         bf_delete(&r);
         throwBFException(state, ret);
@@ -434,9 +570,14 @@ BigInt* BigInt::pow(ExecutionState& state, BigInt* b)
 
 BigInt* BigInt::bitwiseAnd(ExecutionState& state, BigInt* b)
 {
+    // int64_t uses two's complement representation like BigInt
+    if (m_hasSmallValue && b->m_hasSmallValue) {
+        return new BigInt(static_cast<int64_t>(m_smallValue & b->m_smallValue));
+    }
+
     bf_t r;
     bf_init(ThreadLocal::bfContext(), &r);
-    int ret = bf_logic_and(&r, &m_bf, &b->m_bf);
+    int ret = bf_logic_and(&r, bf(), b->bf());
     if (UNLIKELY(ret)) {
         bf_delete(&r);
         throwBFException(state, ret);
@@ -446,9 +587,13 @@ BigInt* BigInt::bitwiseAnd(ExecutionState& state, BigInt* b)
 
 BigInt* BigInt::bitwiseOr(ExecutionState& state, BigInt* b)
 {
+    if (m_hasSmallValue && b->m_hasSmallValue) {
+        return new BigInt(static_cast<int64_t>(m_smallValue | b->m_smallValue));
+    }
+
     bf_t r;
     bf_init(ThreadLocal::bfContext(), &r);
-    int ret = bf_logic_or(&r, &m_bf, &b->m_bf);
+    int ret = bf_logic_or(&r, bf(), b->bf());
     if (UNLIKELY(ret)) {
         bf_delete(&r);
         throwBFException(state, ret);
@@ -458,9 +603,13 @@ BigInt* BigInt::bitwiseOr(ExecutionState& state, BigInt* b)
 
 BigInt* BigInt::bitwiseXor(ExecutionState& state, BigInt* b)
 {
+    if (m_hasSmallValue && b->m_hasSmallValue) {
+        return new BigInt(static_cast<int64_t>(m_smallValue ^ b->m_smallValue));
+    }
+
     bf_t r;
     bf_init(ThreadLocal::bfContext(), &r);
-    int ret = bf_logic_xor(&r, &m_bf, &b->m_bf);
+    int ret = bf_logic_xor(&r, bf(), b->bf());
     if (UNLIKELY(ret)) {
         bf_delete(&r);
         throwBFException(state, ret);
@@ -468,8 +617,42 @@ BigInt* BigInt::bitwiseXor(ExecutionState& state, BigInt* b)
     return new BigInt(r);
 }
 
+// returns false when result doesn't fit in int64_t
+static bool shiftSmallValue(int64_t value, int64_t shift, int64_t& result)
+{
+    if (shift >= 0) {
+        if (shift >= 63) {
+            if (value) {
+                return false;
+            }
+            result = 0;
+            return true;
+        }
+        int64_t shifted = static_cast<int64_t>(static_cast<uint64_t>(value) << shift);
+        if ((shifted >> shift) != value) {
+            return false;
+        }
+        result = shifted;
+        return true;
+    }
+
+    // right shift rounds toward negative infinity
+    if (shift <= -63) {
+        result = value < 0 ? -1 : 0;
+    } else {
+        result = value >> -shift;
+    }
+    return true;
+}
+
 BigInt* BigInt::leftShift(ExecutionState& state, BigInt* src)
 {
+    int64_t result;
+    if (m_hasSmallValue && src->m_hasSmallValue && src->m_smallValue != std::numeric_limits<int64_t>::min()
+        && shiftSmallValue(m_smallValue, src->m_smallValue, result)) {
+        return new BigInt(result);
+    }
+
     bf_t r;
     bf_init(ThreadLocal::bfContext(), &r);
 
@@ -486,7 +669,7 @@ BigInt* BigInt::leftShift(ExecutionState& state, BigInt* src)
 #endif
     // if (op == OP_sar)
     //     v2 = -v2;
-    int ret = bf_set(&r, &m_bf);
+    int ret = bf_set(&r, bf());
     ret |= bf_mul_2exp(&r, v2, BF_PREC_INF, BF_RNDZ);
     if (v2 < 0) {
         ret |= bf_rint(&r, BF_RNDD) & (BF_ST_OVERFLOW | BF_ST_MEM_ERROR);
@@ -500,6 +683,12 @@ BigInt* BigInt::leftShift(ExecutionState& state, BigInt* src)
 
 BigInt* BigInt::rightShift(ExecutionState& state, BigInt* src)
 {
+    int64_t result;
+    if (m_hasSmallValue && src->m_hasSmallValue && src->m_smallValue != std::numeric_limits<int64_t>::min()
+        && shiftSmallValue(m_smallValue, -src->m_smallValue, result)) {
+        return new BigInt(result);
+    }
+
     bf_t r;
     bf_init(ThreadLocal::bfContext(), &r);
 
@@ -515,7 +704,7 @@ BigInt* BigInt::rightShift(ExecutionState& state, BigInt* src)
         v2 = std::numeric_limits<int64_t>::min() + 1;
 #endif
     v2 = -v2;
-    int ret = bf_set(&r, &m_bf);
+    int ret = bf_set(&r, bf());
     ret |= bf_mul_2exp(&r, v2, BF_PREC_INF, BF_RNDZ);
     if (v2 < 0) {
         ret |= bf_rint(&r, BF_RNDD) & (BF_ST_OVERFLOW | BF_ST_MEM_ERROR);
@@ -533,9 +722,13 @@ BigInt* BigInt::rightShift(ExecutionState& state, BigInt* src)
 
 BigInt* BigInt::increment(ExecutionState& state)
 {
+    if (m_hasSmallValue && m_smallValue != std::numeric_limits<int64_t>::max()) {
+        return new BigInt(static_cast<int64_t>(m_smallValue + 1));
+    }
+
     bf_t r;
     bf_init(ThreadLocal::bfContext(), &r);
-    int ret = bf_add_si(&r, &m_bf, 1, BF_PREC_INF, BF_RNDZ);
+    int ret = bf_add_si(&r, bf(), 1, BF_PREC_INF, BF_RNDZ);
     if (UNLIKELY(ret)) {
         bf_delete(&r);
         throwBFException(state, ret);
@@ -545,9 +738,13 @@ BigInt* BigInt::increment(ExecutionState& state)
 
 BigInt* BigInt::decrement(ExecutionState& state)
 {
+    if (m_hasSmallValue && m_smallValue != std::numeric_limits<int64_t>::min()) {
+        return new BigInt(static_cast<int64_t>(m_smallValue - 1));
+    }
+
     bf_t r;
     bf_init(ThreadLocal::bfContext(), &r);
-    int ret = bf_add_si(&r, &m_bf, -1, BF_PREC_INF, BF_RNDZ);
+    int ret = bf_add_si(&r, bf(), -1, BF_PREC_INF, BF_RNDZ);
     if (UNLIKELY(ret)) {
         bf_delete(&r);
         throwBFException(state, ret);
@@ -557,10 +754,14 @@ BigInt* BigInt::decrement(ExecutionState& state)
 
 BigInt* BigInt::bitwiseNot(ExecutionState& state)
 {
+    if (m_hasSmallValue) {
+        return new BigInt(static_cast<int64_t>(~m_smallValue));
+    }
+
     // The abstract operation BigInt::bitwiseNOT with an argument x of BigInt type returns the one's complement of x; that is, -x - 1.
     bf_t r;
     bf_init(ThreadLocal::bfContext(), &r);
-    int ret = bf_add_si(&r, &m_bf, 1, BF_PREC_INF, BF_RNDZ);
+    int ret = bf_add_si(&r, bf(), 1, BF_PREC_INF, BF_RNDZ);
     bf_neg(&r);
 
     if (UNLIKELY(ret)) {
@@ -576,9 +777,13 @@ BigInt* BigInt::negativeValue(ExecutionState& state)
         return this;
     }
 
+    if (m_hasSmallValue && m_smallValue != std::numeric_limits<int64_t>::min()) {
+        return new BigInt(static_cast<int64_t>(-m_smallValue));
+    }
+
     bf_t r;
     bf_init(ThreadLocal::bfContext(), &r);
-    int ret = bf_set(&r, &m_bf);
+    int ret = bf_set(&r, bf());
     bf_neg(&r);
     if (UNLIKELY(ret)) {
         bf_delete(&r);
@@ -595,9 +800,13 @@ BigInt* BigInt::negativeValue()
         return this;
     }
 
+    if (m_hasSmallValue && m_smallValue != std::numeric_limits<int64_t>::min()) {
+        return new BigInt(static_cast<int64_t>(-m_smallValue));
+    }
+
     bf_t r;
     bf_init(ThreadLocal::bfContext(), &r);
-    int ret = bf_set(&r, &m_bf);
+    int ret = bf_set(&r, bf());
     bf_neg(&r);
     ASSERT(!ret);
     return new BigInt(r);
@@ -605,21 +814,33 @@ BigInt* BigInt::negativeValue()
 
 bool BigInt::isZero()
 {
+    if (m_hasSmallValue) {
+        return m_smallValue == 0;
+    }
     return bf_is_zero(&m_bf);
 }
 
 bool BigInt::isNaN()
 {
+    if (m_hasSmallValue) {
+        return false;
+    }
     return bf_is_nan(&m_bf);
 }
 
 bool BigInt::isInfinity()
 {
+    if (m_hasSmallValue) {
+        return false;
+    }
     return !bf_is_finite(&m_bf);
 }
 
 bool BigInt::isNegative()
 {
+    if (m_hasSmallValue) {
+        return m_smallValue < 0;
+    }
     return m_bf.sign;
 }
 
@@ -112,8 +112,23 @@ public:
     bool isInfinity();
     bool isNegative();
 
+    // true when value fits in int64_t
+    bool hasSmallValue() const
+    {
+        return m_hasSmallValue;
+    }
+
+    int64_t smallValue() const
+    {
+        ASSERT(m_hasSmallValue);
+        return m_smallValue;
+    }
+
     bf_t* bf()
     {
+        if (UNLIKELY(!m_hasBF)) {
+            initBFFromSmallValue();
+        }
         return &m_bf;
     }
 
@@ -121,8 +136,15 @@ private:
     BigInt();
 
     void initFinalizer();
+    void initBFFromSmallValue();
+    void initSmallValueFromBF();
 
     size_t m_tag;
+    // small value is stored without libbf
+    // m_bf is initialized lazily when libbf operation is needed
+    bool m_hasSmallValue;
+    bool m_hasBF;
+    int64_t m_smallValue;
     bf_t m_bf;
 };
 } // namespace Escargot
@@ -25,8 +25,56 @@
 #include "runtime/VMInstance.h"
 #include "lz4.h"
 
+#ifndef ESCARGOT_COMPRESSIBLE_CHUNK_SIZE
+#define ESCARGOT_COMPRESSIBLE_CHUNK_SIZE 1024 * 64
+#endif
+#ifndef ESCARGOT_COMPRESSIBLE_WINDOW_MAX_CHUNK_COUNT
+#define ESCARGOT_COMPRESSIBLE_WINDOW_MAX_CHUNK_COUNT 4
+#endif
+
 namespace Escargot {
 
+constexpr static const size_t g_compressChunkSize = ESCARGOT_COMPRESSIBLE_CHUNK_SIZE;
+static_assert(g_compressChunkSize <= LZ4_MAX_INPUT_SIZE, "");
+
+static ATTRIBUTE_NO_SANITIZE_ADDRESS bool testPointerExistsOnStack(size_t* start, size_t* end, const void* ptr)
+{
+    while (start != end) {
+        if (UNLIKELY(*start == (size_t)ptr)) {
+            // if there is reference on stack, we cannot compress string.
+            return true;
+        }
+        start++;
+    }
+
+    return false;
+}
+
+static ATTRIBUTE_NO_SANITIZE_ADDRESS bool testPointerIntoRangeExistsOnStack(size_t* start, size_t* end, const char* begin, size_t byteLength)
+{
+    while (start != end) {
+        // pointer to end of range is included for loops reading the buffer
+        if (UNLIKELY(*start >= (size_t)begin && *start <= (size_t)begin + byteLength)) {
+            return true;
+        }
+        start++;
+    }
+
+    return false;
+}
+
+static bool testPointerExistsOnStack(VMInstance* instance, void* callerSP, const void* ptr)
+{
+#if defined(STACK_GROWS_DOWN)
+    size_t* start = (size_t*)((size_t)callerSP & ~(sizeof(size_t) - 1));
+    size_t* end = (size_t*)instance->stackStartAddress();
+#else
+    size_t* start = (size_t*)instance->stackStartAddress();
+    size_t* end = (size_t*)((size_t)callerSP & ~(sizeof(size_t) - 1));
+#endif
+    return testPointerExistsOnStack(start, end, ptr);
+}
+
 void* CompressibleString::operator new(size_t size)
 {
     static MAY_THREAD_LOCAL bool typeInited = false;
@@ -46,24 +94,42 @@ CompressibleString::CompressibleString(VMInstance* instance)
     , m_isCompressed(false)
     , m_vmInstance(instance)
     , m_lastUsedTickcount(fastTickCount())
+    , m_decompressedWindow(nullptr)
+    , m_decompressedWindowStart(0)
+    , m_decompressedWindowByteLength(0)
+    , m_retiredDecompressedWindowCount(0)
+    , m_moreRecentlyUsed(nullptr)
+    , m_lessRecentlyUsed(nullptr)
+#if defined(ENABLE_THREADING)
+    , m_compressionTask(nullptr)
+#endif
 {
     m_bufferData.hasSpecialImpl = true;
 
-    auto& v = instance->compressibleStrings();
-    v.push_back(this);
+    linkAsMostRecentlyUsed();
     GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void*) {
         CompressibleString* self = (CompressibleString*)obj;
-        if (self->isCompressed()) {
+        if (self->isCompressionPending()) {
+#if defined(ENABLE_THREADING)
+            // original buffer is released with the task
+            self->m_compressionTask->m_string = nullptr;
+#endif
+        } else if (self->isCompressed()) {
             self->m_compressedData.~CompressedDataVector();
         } else {
             deallocateStringDataBuffer(const_cast<void*>(self->m_bufferData.buffer), self->m_bufferData.length * (self->m_bufferData.has8BitContent ? 1 : 2));
         }
+        if (self->m_decompressedWindow) {
+            deallocateStringDataBuffer(self->m_decompressedWindow, self->m_decompressedWindowByteLength);
+        }
+        for (size_t i = 0; i < self->m_retiredDecompressedWindowCount; i++) {
+            deallocateStringDataBuffer(self->m_retiredDecompressedWindows[i].first, self->m_retiredDecompressedWindows[i].second);
+        }
 
         if (!self->m_isOwnerMayFreed) {
             self->m_vmInstance->compressibleStringsUncomressedBufferSize() -= self->decomressedBufferSize();
 
-            auto& v = self->m_vmInstance->compressibleStrings();
-            v.erase(std::find(v.begin(), v.end(), self));
+            self->unlinkFromUsedList();
         }
     },
                                    nullptr, nullptr, nullptr);
@@ -99,6 +165,45 @@ CompressibleString::CompressibleString(VMInstance* instance, void* buffer, size_
     initBufferAccessData(buffer, stringLength, is8bit);
 }
 
+void CompressibleString::linkAsMostRecentlyUsed()
+{
+    CompressibleString*& mostRecentlyUsed = m_vmInstance->mostRecentlyUsedCompressibleString();
+    m_moreRecentlyUsed = nullptr;
+    m_lessRecentlyUsed = mostRecentlyUsed;
+    if (mostRecentlyUsed) {
+        mostRecentlyUsed->m_moreRecentlyUsed = this;
+    } else {
+        m_vmInstance->leastRecentlyUsedCompressibleString() = this;
+    }
+    mostRecentlyUsed = this;
+}
+
+void CompressibleString::unlinkFromUsedList()
+{
+    if (m_moreRecentlyUsed) {
+        m_moreRecentlyUsed->m_lessRecentlyUsed = m_lessRecentlyUsed;
+    } else {
+        ASSERT(m_vmInstance->mostRecentlyUsedCompressibleString() == this);
+        m_vmInstance->mostRecentlyUsedCompressibleString() = m_lessRecentlyUsed;
+    }
+
+    if (m_lessRecentlyUsed) {
+        m_lessRecentlyUsed->m_moreRecentlyUsed = m_moreRecentlyUsed;
+    } else {
+        ASSERT(m_vmInstance->leastRecentlyUsedCompressibleString() == this);
+        m_vmInstance->leastRecentlyUsedCompressibleString() = m_moreRecentlyUsed;
+    }
+
+    m_moreRecentlyUsed = m_lessRecentlyUsed = nullptr;
+}
+
+void CompressibleString::moveToMostRecentlyUsed()
+{
+    ASSERT(m_moreRecentlyUsed);
+    unlinkFromUsedList();
+    linkAsMostRecentlyUsed();
+}
+
 void CompressibleString::initBufferAccessData(void* data, size_t len, bool is8bit)
 {
     m_bufferData.has8BitContent = is8bit;
@@ -146,7 +251,7 @@ void CompressibleString::deallocateStringDataBuffer(void* ptr, size_t byteLength
 bool CompressibleString::compress()
 {
     ASSERT(!m_isCompressed);
-    if (UNLIKELY(!m_bufferData.length)) {
+    if (UNLIKELY(!m_bufferData.length || isCompressionPending())) {
         return false;
     }
 
@@ -171,66 +276,164 @@ void CompressibleString::decompress()
     }
 }
 
-constexpr static const size_t g_compressChunkSize = 1044465;
-static_assert(LZ4_COMPRESSBOUND(g_compressChunkSize) == 1024 * 1024, "");
+StringBufferAccessData CompressibleString::bufferAccessDataOfRange(size_t start, size_t length)
+{
+    ASSERT(start + length <= m_bufferData.length);
+    markAsUsed();
 
-static ATTRIBUTE_NO_SANITIZE_ADDRESS bool testPointerExistsOnStack(size_t* start, size_t* end, const void* ptr)
+    size_t charSize = m_bufferData.has8BitContent ? 1 : 2;
+    if (!isCompressed()) {
+        return StringBufferAccessData(m_bufferData.has8BitContent, length,
+                                      const_cast<char*>(m_bufferData.bufferAs8Bit) + start * charSize, const_cast<void*>(m_bufferData.buffer));
+    }
+
+    if (UNLIKELY(!length)) {
+        return StringBufferAccessData(m_bufferData.has8BitContent, 0, const_cast<char*>(""));
+    }
+
+    size_t byteStart = start * charSize;
+    size_t byteEnd = (start + length) * charSize;
+    if (!m_decompressedWindow || byteStart < m_decompressedWindowStart || byteEnd > m_decompressedWindowStart + m_decompressedWindowByteLength) {
+        if (!decompressWindow(byteStart, byteEnd)) {
+            // range is too large or too many windows are waiting to be released
+            decompress();
+            return bufferAccessDataOfRange(start, length);
+        }
+    }
+
+    return StringBufferAccessData(m_bufferData.has8BitContent, length,
+                                  m_decompressedWindow + (byteStart - m_decompressedWindowStart), m_decompressedWindow);
+}
+
+bool CompressibleString::decompressWindow(size_t byteStart, size_t byteEnd)
 {
-    while (start != end) {
-        if (UNLIKELY(*start == (size_t)ptr)) {
-            // if there is reference on stack, we cannot compress string.
-            return true;
+    ASSERT(m_isCompressed);
+    ASSERT(byteStart < byteEnd);
+
+    size_t firstChunk = byteStart / g_compressChunkSize;
+    size_t lastChunk = (byteEnd - 1) / g_compressChunkSize;
+    if (lastChunk - firstChunk + 1 > ESCARGOT_COMPRESSIBLE_WINDOW_MAX_CHUNK_COUNT) {
+        return false;
+    }
+
+    if (m_decompressedWindow) {
+        // old window can be read by callers (e.g. StringBuilder holding StringBufferAccessData)
+        // so it is retired instead of freed here
+        if (m_retiredDecompressedWindowCount == ESCARGOT_COMPRESSIBLE_RETIRED_WINDOW_MAX_COUNT) {
+            return false;
         }
-        start++;
+        m_retiredDecompressedWindows[m_retiredDecompressedWindowCount++] = std::make_pair(m_decompressedWindow, m_decompressedWindowByteLength);
+        m_decompressedWindow = nullptr;
     }
 
-    return false;
+    size_t originByteLength = m_bufferData.length * (m_bufferData.has8BitContent ? 1 : 2);
+    size_t windowStart = firstChunk * g_compressChunkSize;
+    size_t windowEnd = std::min((lastChunk + 1) * g_compressChunkSize, originByteLength);
+    char* window = (char*)allocateStringDataBuffer(windowEnd - windowStart);
+
+    for (size_t bufIndex = firstChunk; bufIndex <= lastChunk; bufIndex++) {
+        size_t srcIndex = bufIndex * g_compressChunkSize;
+        int srcSize = (int)std::min(g_compressChunkSize, originByteLength - srcIndex);
+
+        int decompressedLength = LZ4::LZ4_decompress_safe(m_compressedData[bufIndex].data(), window + (srcIndex - windowStart), m_compressedData[bufIndex].size(), srcSize);
+        if (decompressedLength != srcSize) {
+            // decompress fail
+            RELEASE_ASSERT_NOT_REACHED();
+        }
+    }
+
+    m_decompressedWindow = window;
+    m_decompressedWindowStart = windowStart;
+    m_decompressedWindowByteLength = windowEnd - windowStart;
+    return true;
 }
 
-template <typename StringType>
-bool CompressibleString::compressWorker(void* callerSP)
+bool CompressibleString::releaseDecompressedWindow()
 {
-    ASSERT(!m_isCompressed);
-    ASSERT(m_bufferData.length > 0);
+    if (!m_decompressedWindow && !m_retiredDecompressedWindowCount) {
+        return false;
+    }
 
+    // spill callee saved registers into this frame
+    // so pointers held only in registers of callers are found by stack scan of worker
+    jmp_buf registers;
+    setjmp(registers);
+#if defined(COMPILER_GCC) || defined(COMPILER_CLANG)
+    __builtin_unwind_init();
+#endif
+    // volatile prevents tail call which drops this frame before scan
+    volatile bool released = releaseDecompressedWindowWorker();
+    return released;
+}
+
+bool CompressibleString::releaseDecompressedWindowWorker()
+{
 #if defined(STACK_GROWS_DOWN)
-    size_t* start = (size_t*)((size_t)callerSP & ~(sizeof(size_t) - 1));
+    size_t* start = (size_t*)((size_t)currentStackPointer() & ~(sizeof(size_t) - 1));
     size_t* end = (size_t*)m_vmInstance->stackStartAddress();
 #else
     size_t* start = (size_t*)m_vmInstance->stackStartAddress();
-    size_t* end = (size_t*)((size_t)callerSP & ~(sizeof(size_t) - 1));
+    size_t* end = (size_t*)((size_t)currentStackPointer() & ~(sizeof(size_t) - 1));
 #endif
 
-    if (testPointerExistsOnStack(start, end, m_bufferData.buffer)) {
-        return false;
+    size_t keptCount = 0;
+    for (size_t i = 0; i < m_retiredDecompressedWindowCount; i++) {
+        std::pair<char*, size_t> window = m_retiredDecompressedWindows[i];
+        if (testPointerIntoRangeExistsOnStack(start, end, window.first, window.second)) {
+            m_retiredDecompressedWindows[keptCount++] = window;
+        } else {
+            deallocateStringDataBuffer(window.first, window.second);
+        }
     }
+    m_retiredDecompressedWindowCount = keptCount;
 
-    size_t originByteLength = m_bufferData.length * sizeof(StringType);
+    if (m_decompressedWindow && !testPointerIntoRangeExistsOnStack(start, end, m_decompressedWindow, m_decompressedWindowByteLength)) {
+        deallocateStringDataBuffer(m_decompressedWindow, m_decompressedWindowByteLength);
+        m_decompressedWindow = nullptr;
+        m_decompressedWindowStart = 0;
+        m_decompressedWindowByteLength = 0;
+    }
+
+    return !m_decompressedWindow && !m_retiredDecompressedWindowCount;
+}
+
+bool CompressibleString::compressBuffer(const char* buffer, size_t byteLength, CompressedDataVector& result)
+{
     int lastBoundLength = 0;
     std::unique_ptr<char[]> compBuffer;
-    for (size_t srcIndex = 0; srcIndex < originByteLength; srcIndex += g_compressChunkSize) {
-        int srcSize = (int)std::min(g_compressChunkSize, originByteLength - srcIndex);
+    for (size_t srcIndex = 0; srcIndex < byteLength; srcIndex += g_compressChunkSize) {
+        int srcSize = (int)std::min(g_compressChunkSize, byteLength - srcIndex);
         int boundLength = LZ4::LZ4_compressBound(srcSize);
         if (boundLength > lastBoundLength) {
             compBuffer.reset(new char[boundLength]);
             lastBoundLength = boundLength;
         }
 
-        int compressedLength = LZ4::LZ4_compress_default(m_bufferData.bufferAs8Bit + srcIndex, (char*)compBuffer.get(), srcSize, boundLength);
+        int compressedLength = LZ4::LZ4_compress_default(buffer + srcIndex, (char*)compBuffer.get(), srcSize, boundLength);
         if (!compressedLength) {
             // compression fail
             return false;
         }
 
         ASSERT(compressedLength > 0);
-        m_compressedData.push_back(std::vector<char>(compBuffer.get(), compBuffer.get() + compressedLength));
+        result.push_back(std::vector<char>(compBuffer.get(), compBuffer.get() + compressedLength));
     }
 
+    return true;
+}
+
+bool CompressibleString::swapToCompressedData(CompressedDataVector& data)
+{
+    ASSERT(!m_isCompressed);
+    // decompressed windows have the same content with original buffer
+    // so they are kept and reused after compression
+
     m_vmInstance->compressibleStringsUncomressedBufferSize() -= decomressedBufferSize();
 
     // immediately free the original string after compression when there is no reference on stack
     deallocateStringDataBuffer(const_cast<void*>(m_bufferData.buffer), m_bufferData.length * (m_bufferData.has8BitContent ? 1 : 2));
 
+    m_compressedData.swap(data);
     m_bufferData.bufferAs8Bit = nullptr;
     m_isCompressed = true;
 
@@ -239,12 +442,29 @@ bool CompressibleString::compressWorker(void* callerSP)
     for (size_t i = 0; i < m_compressedData.size(); i ++) {
         compressedSize += m_compressedData[i].size();
     }
-    ESCARGOT_LOG_INFO("CompressibleString::compressWorker %fKB -> %fKB\n", originByteLength / 1024.f, compressedSize / 1024.f);
+    ESCARGOT_LOG_INFO("CompressibleString::compress %fKB -> %fKB\n", m_bufferData.length * (m_bufferData.has8BitContent ? 1 : 2) / 1024.f, compressedSize / 1024.f);
     */
 
     return true;
 }
 
+template <typename StringType>
+bool CompressibleString::compressWorker(void* callerSP)
+{
+    ASSERT(!m_isCompressed);
+    ASSERT(m_bufferData.length > 0);
+
+    if (testPointerExistsOnStack(m_vmInstance, callerSP, m_bufferData.buffer)) {
+        return false;
+    }
+
+    CompressedDataVector compressedData;
+    if (!compressBuffer(m_bufferData.bufferAs8Bit, m_bufferData.length * sizeof(StringType), compressedData)) {
+        return false;
+    }
+
+    return swapToCompressedData(compressedData);
+}
 
 template <typename StringType>
 void CompressibleString::decompressWorker()
@@ -275,6 +495,109 @@ void CompressibleString::decompressWorker()
 
     m_vmInstance->compressibleStringsUncomressedBufferSize() += decomressedBufferSize();
 }
+
+#if defined(ENABLE_THREADING)
+bool CompressibleString::compressInBackground()
+{
+    ASSERT(!m_isCompressed);
+    if (UNLIKELY(!m_bufferData.length || isCompressionPending())) {
+        return false;
+    }
+
+    // original buffer is not changed until the result is applied
+    m_compressionTask = new CompressibleStringCompressionTask(this, m_bufferData.bufferAs8Bit,
+                                                              m_bufferData.length * (m_bufferData.has8BitContent ? 1 : 2), m_lastUsedTickcount);
+    m_vmInstance->compressibleStringCompressor()->request(m_compressionTask);
+    return true;
+}
+
+CompressibleStringCompressor::CompressibleStringCompressor(VMInstance* instance)
+    : m_vmInstance(instance)
+    , m_terminate(false)
+{
+    m_thread = std::thread(&CompressibleStringCompressor::workerMain, this);
+}
+
+CompressibleStringCompressor::~CompressibleStringCompressor()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_terminate = true;
+    }
+    m_condition.notify_one();
+    m_thread.join();
+
+    // drop every result
+    m_finishedTasks.insert(m_finishedTasks.end(), m_requestedTasks.begin(), m_requestedTasks.end());
+    for (auto task : m_finishedTasks) {
+        if (task->m_string) {
+            task->m_string->m_compressionTask = nullptr;
+        } else {
+            CompressibleString::deallocateStringDataBuffer(const_cast<char*>(task->m_buffer), task->m_byteLength);
+        }
+        delete task;
+    }
+}
+
+void CompressibleStringCompressor::request(CompressibleStringCompressionTask* task)
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_requestedTasks.push_back(task);
+    }
+    m_condition.notify_one();
+}
+
+void CompressibleStringCompressor::workerMain()
+{
+    while (true) {
+        CompressibleStringCompressionTask* task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this] { return m_terminate || !m_requestedTasks.empty(); });
+            if (m_terminate) {
+                return;
+            }
+            task = m_requestedTasks.front();
+            m_requestedTasks.erase(m_requestedTasks.begin());
+        }
+
+        task->m_succeeded = CompressibleString::compressBuffer(task->m_buffer, task->m_byteLength, task->m_compressedData);
+
+        {
+            std::lock_guard<std::mutex> guard(m_mutex);
+            m_finishedTasks.push_back(task);
+        }
+    }
+}
+
+void CompressibleStringCompressor::applyFinishedTasks()
+{
+    std::vector<CompressibleStringCompressionTask*> tasks;
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        tasks.swap(m_finishedTasks);
+    }
+
+    void* callerSP = currentStackPointer();
+    for (auto task : tasks) {
+        CompressibleString* str = task->m_string;
+        if (!str) {
+            // string was finalized while compressing
+            CompressibleString::deallocateStringDataBuffer(const_cast<char*>(task->m_buffer), task->m_byteLength);
+        } else {
+            ASSERT(str->m_compressionTask == task);
+            str->m_compressionTask = nullptr;
+            // apply only when string is still idle and there is no reference on stack
+            if (task->m_succeeded && str->m_lastUsedTickcount == task->m_requestedTickcount
+                && !testPointerExistsOnStack(m_vmInstance, callerSP, str->m_bufferData.buffer)) {
+                str->swapToCompressedData(task->m_compressedData);
+            }
+        }
+        delete task;
+    }
+}
+#endif
 } // namespace Escargot
 
 #endif // ENABLE_COMPRESSIBLE_STRING
@@ -24,12 +24,67 @@
 
 #include "runtime/String.h"
 
+// count of replaced windows kept until next GC or idle time
+#ifndef ESCARGOT_COMPRESSIBLE_RETIRED_WINDOW_MAX_COUNT
+#define ESCARGOT_COMPRESSIBLE_RETIRED_WINDOW_MAX_COUNT (4)
+#endif
+
 namespace Escargot {
 
 class VMInstance;
+class CompressibleString;
+
+typedef std::vector<std::vector<char>> CompressibleStringCompressedData;
+
+#if defined(ENABLE_THREADING)
+struct CompressibleStringCompressionTask {
+    CompressibleStringCompressionTask(CompressibleString* string, const char* buffer, size_t byteLength, uint64_t requestedTickcount)
+        : m_string(string)
+        , m_buffer(buffer)
+        , m_byteLength(byteLength)
+        , m_requestedTickcount(requestedTickcount)
+        , m_succeeded(false)
+    {
+    }
+
+    // becomes nullptr when string is finalized before task is finished
+    // buffer is owned by task in that case
+    CompressibleString* m_string;
+    const char* m_buffer;
+    size_t m_byteLength;
+    uint64_t m_requestedTickcount;
+    bool m_succeeded;
+    CompressibleStringCompressedData m_compressedData;
+};
+
+// compresses requested string buffers on helper thread
+// result is applied on the owner thread of VMInstance
+class CompressibleStringCompressor {
+public:
+    explicit CompressibleStringCompressor(VMInstance* instance);
+    ~CompressibleStringCompressor();
+
+    void request(CompressibleStringCompressionTask* task);
+    NEVER_INLINE void applyFinishedTasks();
+
+private:
+    void workerMain();
+
+    VMInstance* m_vmInstance;
+    bool m_terminate;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::vector<CompressibleStringCompressionTask*> m_requestedTasks;
+    std::vector<CompressibleStringCompressionTask*> m_finishedTasks;
+    std::thread m_thread;
+};
+#endif
 
 class CompressibleString : public String {
     friend class VMInstance;
+#if defined(ENABLE_THREADING)
+    friend class CompressibleStringCompressor;
+#endif
 
 public:
     // 8bit string constructor
@@ -51,6 +106,11 @@ public:
     virtual UTF8StringData toUTF8StringData() const override;
     virtual UTF8StringDataNonGCStd toNonGCUTF8StringData(int options = StringWriteOption::NoOptions) const override;
 
+    virtual char16_t charAt(const size_t idx) const override
+    {
+        return const_cast<CompressibleString*>(this)->bufferAccessDataOfRange(idx, 1).charAt(0);
+    }
+
     virtual const LChar* characters8() const override
     {
         return (const LChar*)bufferAccessData().buffer;
@@ -63,7 +123,7 @@ public:
 
     virtual StringBufferAccessData bufferAccessDataSpecialImpl() override
     {
-        m_lastUsedTickcount = fastTickCount();
+        markAsUsed();
         if (isCompressed()) {
             decompress();
         }
@@ -75,6 +135,10 @@ public:
         return m_isCompressed;
     }
 
+    // access [start, start + length) of string
+    // only touched chunks are decompressed if string is compressed
+    StringBufferAccessData bufferAccessDataOfRange(size_t start, size_t length);
+
     void* operator new(size_t);
     void* operator new[](size_t) = delete;
     void operator delete[](void*) = delete;
@@ -84,10 +148,36 @@ public:
 
     bool compress();
     void decompress();
+    // should be called only from GC or idle time callback
+    // windows still referenced from stack or registers are kept
+    bool releaseDecompressedWindow();
+#if defined(ENABLE_THREADING)
+    bool compressInBackground();
+#endif
 
 private:
     CompressibleString(VMInstance* instance);
 
+    void markAsUsed()
+    {
+        m_lastUsedTickcount = fastTickCount();
+        if (UNLIKELY(m_moreRecentlyUsed != nullptr)) {
+            moveToMostRecentlyUsed();
+        }
+    }
+    void moveToMostRecentlyUsed();
+    void linkAsMostRecentlyUsed();
+    void unlinkFromUsedList();
+
+    bool isCompressionPending()
+    {
+#if defined(ENABLE_THREADING)
+        return m_compressionTask;
+#else
+        return false;
+#endif
+    }
+
     void initBufferAccessData(void* data, size_t len, bool is8bit);
 
     size_t decomressedBufferSize()
@@ -103,13 +193,32 @@ private:
     NEVER_INLINE bool compressWorker(void* callerSP);
     template <typename StringType>
     NEVER_INLINE void decompressWorker();
+    NEVER_INLINE bool decompressWindow(size_t byteStart, size_t byteEnd);
+    NEVER_INLINE bool releaseDecompressedWindowWorker();
+    static bool compressBuffer(const char* buffer, size_t byteLength, CompressibleStringCompressedData& result);
+    bool swapToCompressedData(CompressibleStringCompressedData& data);
 
     bool m_isOwnerMayFreed;
     bool m_isCompressed;
     VMInstance* m_vmInstance;
     uint64_t m_lastUsedTickcount;
-    typedef std::vector<std::vector<char>> CompressedDataVector;
+    // each chunk holds ESCARGOT_COMPRESSIBLE_CHUNK_SIZE bytes of original data
+    typedef CompressibleStringCompressedData CompressedDataVector;
     CompressedDataVector m_compressedData;
+    // decompressed part of compressed data
+    char* m_decompressedWindow;
+    size_t m_decompressedWindowStart;
+    size_t m_decompressedWindowByteLength;
+    // windows replaced on access path. caller can still read them
+    // so they are freed only by releaseDecompressedWindow
+    std::pair<char*, size_t> m_retiredDecompressedWindows[ESCARGOT_COMPRESSIBLE_RETIRED_WINDOW_MAX_COUNT];
+    size_t m_retiredDecompressedWindowCount;
+    // LRU list of VMInstance (not traced by GC)
+    CompressibleString* m_moreRecentlyUsed;
+    CompressibleString* m_lessRecentlyUsed;
+#if defined(ENABLE_THREADING)
+    CompressibleStringCompressionTask* m_compressionTask;
+#endif
 };
 } // namespace Escargot
 
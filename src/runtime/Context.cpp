@@ -84,6 +84,7 @@ Context::Context(VMInstance* instance)
     , m_securityPolicyCheckCallback(nullptr)
     , m_virtualIdentifierCallbackPublic(nullptr)
     , m_securityPolicyCheckCallbackPublic(nullptr)
+    , m_errorStackGetter(nullptr)
 #ifdef ESCARGOT_DEBUGGER
     , m_debugger(nullptr)
 #endif /* ESCARGOT_DEBUGGER */
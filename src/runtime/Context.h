@@ -372,6 +372,9 @@ private:
 
     InstantiatedFunctionObjects m_instantiatedFunctionObjects;
 
+    // getter of `stack` property of thrown error objects
+    Object* m_errorStackGetter;
+
 #ifdef ESCARGOT_DEBUGGER
     // debugger support
     Debugger* m_debugger;
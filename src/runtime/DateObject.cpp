@@ -273,14 +273,11 @@ static int equivalentYearForDST(int year)
 // e.g. return (t - 32400*1000) on KST zone
 time64_t DateObject::applyLocalTimezoneOffset(ExecutionState& state, time64_t t)
 {
-#if defined(ENABLE_ICU)
-    UErrorCode succ = U_ZERO_ERROR;
-#endif
     int32_t stdOffset = 0, dstOffset = 0;
 
 // roughly check range before calling yearFromTime function
 #if defined(ENABLE_ICU)
-    stdOffset = vzone_getRawOffset(state.context()->vmInstance()->timezone());
+    stdOffset = state.context()->vmInstance()->timezoneRawOffset();
 #else
     stdOffset = 0;
 #endif
@@ -300,14 +297,14 @@ time64_t DateObject::applyLocalTimezoneOffset(ExecutionState& state, time64_t t)
 
     t += msBetweenYears;
 #if defined(ENABLE_ICU)
-    vzone_getOffset3(state.context()->vmInstance()->timezone(), t, true, stdOffset, dstOffset, succ);
+    bool succ = state.context()->vmInstance()->timezoneOffset(t, stdOffset, dstOffset);
 #else
     dstOffset = 0;
 #endif
     t -= msBetweenYears;
 #if defined(ENABLE_ICU)
     // range check should be completed by caller function
-    if (!U_FAILURE(succ)) {
+    if (succ) {
         return t - (stdOffset + dstOffset);
     }
     return TIME64NAN;
@@ -1118,8 +1115,7 @@ void DateObject::resolveCache(ExecutionState& state)
 
     int32_t stdOffset = 0, dstOffset = 0;
 #if defined(ENABLE_ICU)
-    UErrorCode succ = U_ZERO_ERROR;
-    vzone_getOffset3(state.context()->vmInstance()->timezone(), t, true, stdOffset, dstOffset, succ);
+    state.context()->vmInstance()->timezoneOffset(t, stdOffset, dstOffset);
 #endif
 
     m_cachedLocal.isdst = dstOffset == 0 ? 0 : 1;
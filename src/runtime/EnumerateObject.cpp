@@ -85,6 +85,7 @@ void* EnumerateObjectWithIteration::operator new(size_t size)
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(EnumerateObjectWithIteration, m_keys));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(EnumerateObjectWithIteration, m_object));
         GC_set_bit(obj_bitmap, GC_WORD_OFFSET(EnumerateObjectWithIteration, m_hiddenClassChain));
+        GC_set_bit(obj_bitmap, GC_WORD_OFFSET(EnumerateObjectWithIteration, m_keyCache));
         descr = GC_make_descriptor(obj_bitmap, GC_WORD_LEN(EnumerateObjectWithIteration));
         typeInited = true;
     }
@@ -177,10 +178,55 @@ bool EnumerateObjectWithDestruction::checkIfModified(ExecutionState& state)
     return false;
 }
 
+bool EnumerateObjectWithIteration::tryToUseKeyCache(EncodedValueVector& keys)
+{
+    if (!m_object->isPlainObject()) {
+        return false;
+    }
+
+    EnumerateObjectKeyCache* cache = m_object->structure()->enumerateObjectKeyCache();
+    if (!cache) {
+        return false;
+    }
+
+    // structure has no information about prototype, so check prototype chain
+    Optional<Object*> proto = m_object->rawInternalPrototypeObject();
+    for (size_t i = 0; i < cache->m_prototypeChain.size(); i++) {
+        if (!proto || proto.value() != cache->m_prototypeChain[i] || proto.value()->structure() != cache->m_hiddenClassChain[i + 1]) {
+            return false;
+        }
+        proto = proto.value()->rawInternalPrototypeObject();
+    }
+    if (proto) {
+        return false;
+    }
+
+    keys.assign(cache->m_keys.data(), cache->m_keys.data() + cache->m_keys.size());
+    m_keyCache = cache;
+    return true;
+}
+
+void EnumerateObjectWithIteration::buildKeyCache(const EncodedValueVector& keys)
+{
+    EnumerateObjectKeyCache* cache = new EnumerateObjectKeyCache();
+    cache->m_keys.assign(keys.data(), keys.data() + keys.size());
+    cache->m_hiddenClassChain.assign(m_hiddenClassChain.data(), m_hiddenClassChain.data() + m_hiddenClassChain.size());
+
+    Optional<Object*> proto = m_object->rawInternalPrototypeObject();
+    while (proto) {
+        cache->m_prototypeChain.pushBack(proto.value());
+        proto = proto.value()->rawInternalPrototypeObject();
+    }
+    ASSERT(cache->m_hiddenClassChain.size() == cache->m_prototypeChain.size() + 1);
+
+    m_object->structure()->setEnumerateObjectKeyCache(cache);
+}
+
 void EnumerateObjectWithIteration::executeEnumeration(ExecutionState& state, EncodedValueVector& keys)
 {
     ASSERT(!!m_object);
     m_hiddenClassChain.clear();
+    m_keyCache = nullptr;
 
     if (UNLIKELY(m_object->isArrayObject())) {
         m_arrayLength = m_object->asArrayObject()->arrayLength(state);
@@ -188,7 +234,13 @@ void EnumerateObjectWithIteration::executeEnumeration(ExecutionState& state, Enc
         return;
     }
 
+    if (tryToUseKeyCache(keys)) {
+        return;
+    }
+
     bool shouldSearchProto = false;
+    // key list of plain object depends only on structures of prototype chain
+    bool canUseKeyCache = m_object->isPlainObject() && m_object->structure()->inTransitionMode();
 
     m_hiddenClassChain.push_back(m_object->structure());
 
@@ -208,6 +260,7 @@ void EnumerateObjectWithIteration::executeEnumeration(ExecutionState& state, Enc
                                           &shouldSearchProto);
         }
         ASSERT(!!proto.asObject()->structure());
+        canUseKeyCache = canUseKeyCache && proto.asObject()->isPlainObject();
         m_hiddenClassChain.push_back(proto.asObject()->structure());
         proto = proto.asObject()->getPrototype(state);
     }
@@ -278,6 +331,10 @@ void EnumerateObjectWithIteration::executeEnumeration(ExecutionState& state, Enc
         for (auto& v : properties.strings) {
             keys[idx++] = v;
         }
+
+        if (canUseKeyCache) {
+            buildKeyCache(keys);
+        }
     }
 
     if (m_object->hasRareData()) {
@@ -287,9 +344,10 @@ void EnumerateObjectWithIteration::executeEnumeration(ExecutionState& state, Enc
 
 bool EnumerateObjectWithIteration::checkIfModified(ExecutionState& state)
 {
+    const ObjectStructureChain& hiddenClassChain = m_keyCache ? m_keyCache->m_hiddenClassChain : m_hiddenClassChain;
     Object* obj = m_object;
-    for (size_t i = 0; i < m_hiddenClassChain.size(); i++) {
-        auto hc = m_hiddenClassChain[i];
+    for (size_t i = 0; i < hiddenClassChain.size(); i++) {
+        auto hc = hiddenClassChain[i];
         ObjectStructure* structure = obj->structure();
         if (UNLIKELY(hc != structure)) {
             return true;
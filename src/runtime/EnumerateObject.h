@@ -82,12 +82,24 @@ protected:
     ObjectStructure* m_hiddenClass;
 };
 
+typedef Vector<ObjectStructure*, GCUtil::gc_malloc_allocator<ObjectStructure*>> ObjectStructureChain;
+
+// for-in key list of plain object memoized in its ObjectStructure
+// valid while prototype chain has same objects with same structures
+// (every object in the chain is plain object and prototypes have no enumerable property)
+struct EnumerateObjectKeyCache : public gc {
+    EncodedValueVector m_keys;
+    ObjectStructureChain m_hiddenClassChain; // own structure followed by structure of each prototype
+    Vector<Object*, GCUtil::gc_malloc_allocator<Object*>> m_prototypeChain;
+};
+
 // enumerate object for iteration operation (for-in)
 // exclude symbol, include prototype chain and check modification during enumetation
 class EnumerateObjectWithIteration : public EnumerateObject {
 public:
     EnumerateObjectWithIteration(ExecutionState& state, Object* obj)
         : EnumerateObject(obj)
+        , m_keyCache(nullptr)
     {
         executeEnumeration(state, m_keys);
     }
@@ -99,7 +111,11 @@ protected:
     virtual void executeEnumeration(ExecutionState& state, EncodedValueVector& keys) override;
     virtual bool checkIfModified(ExecutionState& state) override;
 
-    Vector<ObjectStructure*, GCUtil::gc_malloc_allocator<ObjectStructure*>> m_hiddenClassChain;
+    bool tryToUseKeyCache(EncodedValueVector& keys);
+    void buildKeyCache(const EncodedValueVector& keys);
+
+    ObjectStructureChain m_hiddenClassChain;
+    EnumerateObjectKeyCache* m_keyCache; // m_hiddenClassChain is not used when enumeration came from cache
 };
 } // namespace Escargot
 
@@ -440,6 +440,7 @@ void ModuleEnvironmentRecord::createBinding(ExecutionState& state, const AtomicS
     record.m_isMutable = isMutable;
     record.m_isVarDeclaration = isVarDeclaration;
     record.m_targetRecord = nullptr;
+    record.m_targetBindingIndex = SIZE_MAX;
     record.m_value = isVarDeclaration ? Value() : Value(Value::EmptyValue);
     m_moduleBindings.pushBack(record);
 }
@@ -495,7 +496,7 @@ EnvironmentRecord::GetBindingValueResult ModuleEnvironmentRecord::getBindingValu
     for (size_t i = 0; i < len; i++) {
         if (m_moduleBindings[i].m_localName == name) {
             if (m_moduleBindings[i].m_targetRecord) {
-                return m_moduleBindings[i].m_targetRecord->getBindingValue(state, m_moduleBindings[i].m_targetBindingName);
+                return GetBindingValueResult(getImportedBindingValue(state, i));
             } else {
                 readCheck(state, i);
                 return GetBindingValueResult(m_moduleBindings[i].m_value);
@@ -508,7 +509,7 @@ EnvironmentRecord::GetBindingValueResult ModuleEnvironmentRecord::getBindingValu
 Value ModuleEnvironmentRecord::getBindingValue(ExecutionState& state, const size_t i)
 {
     if (m_moduleBindings[i].m_targetRecord) {
-        return m_moduleBindings[i].m_targetRecord->getBindingValue(state, m_moduleBindings[i].m_targetBindingName).m_value;
+        return getImportedBindingValue(state, i);
     } else {
         readCheck(state, i);
         return m_moduleBindings[i].m_value;
@@ -525,7 +526,7 @@ void ModuleEnvironmentRecord::setHeapValueByIndex(ExecutionState& state, const s
 Value ModuleEnvironmentRecord::getHeapValueByIndex(ExecutionState& state, const size_t i)
 {
     if (m_moduleBindings[i].m_targetRecord) {
-        return m_moduleBindings[i].m_targetRecord->getBindingValue(state, m_moduleBindings[i].m_targetBindingName).m_value;
+        return getImportedBindingValue(state, i);
     } else {
         readCheck(state, i);
         return m_moduleBindings[i].m_value;
@@ -540,15 +541,50 @@ void ModuleEnvironmentRecord::createImportBinding(ExecutionState& state, AtomicS
     // Assert: When M.[[Environment]] is instantiated it will have a direct binding for N2.
     // Create an immutable indirect binding in envRec for N that references M and N2 as its target binding and record that the binding is initialized.
     // Return NormalCompletion(empty).
+    // resolve target binding into slot index here
+    // so reading imported binding does not need to search binding by name
+    size_t targetIndex = targetRecord->hasBinding(state, targetBindingName).m_index;
+    // follow re-exported import binding which is already linked
+    while (targetIndex != SIZE_MAX && targetRecord->m_moduleBindings[targetIndex].m_targetRecord) {
+        const ModuleBindingRecord& targetBinding = targetRecord->m_moduleBindings[targetIndex];
+        targetBindingName = targetBinding.m_targetBindingName;
+        targetIndex = targetBinding.m_targetBindingIndex;
+        targetRecord = targetBinding.m_targetRecord;
+    }
+
     size_t len = m_moduleBindings.size();
     for (size_t i = 0; i < len; i++) {
         if (m_moduleBindings[i].m_localName == localName) {
             ASSERT(m_moduleBindings[i].m_targetRecord == nullptr);
             m_moduleBindings[i].m_targetRecord = targetRecord;
             m_moduleBindings[i].m_targetBindingName = targetBindingName;
+            m_moduleBindings[i].m_targetBindingIndex = targetIndex;
             return;
         }
     }
     ASSERT_NOT_REACHED();
 }
+
+Value ModuleEnvironmentRecord::getImportedBindingValue(ExecutionState& state, const size_t i)
+{
+    ModuleBindingRecord& binding = m_moduleBindings[i];
+    ASSERT(binding.m_targetRecord);
+    if (UNLIKELY(binding.m_targetBindingIndex == SIZE_MAX)) {
+        // target binding was not found on linking
+        binding.m_targetBindingIndex = binding.m_targetRecord->hasBinding(state, binding.m_targetBindingName).m_index;
+        if (binding.m_targetBindingIndex == SIZE_MAX) {
+            return binding.m_targetRecord->getBindingValue(state, binding.m_targetBindingName).m_value;
+        }
+    }
+
+    ModuleEnvironmentRecord* targetRecord = binding.m_targetRecord;
+    size_t targetIndex = binding.m_targetBindingIndex;
+    if (UNLIKELY(targetRecord->m_moduleBindings[targetIndex].m_targetRecord != nullptr)) {
+        // target is an import binding linked after this binding
+        return targetRecord->getImportedBindingValue(state, targetIndex);
+    }
+
+    targetRecord->readCheck(state, targetIndex);
+    return targetRecord->m_moduleBindings[targetIndex].m_value;
+}
 } // namespace Escargot
@@ -413,6 +413,8 @@ public:
 };
 
 class DeclarativeEnvironmentRecordIndexed : public DeclarativeEnvironmentRecord {
+    friend class HeapSnapshot;
+
 public:
     DeclarativeEnvironmentRecordIndexed(ExecutionState& state, InterpretedCodeBlock::BlockInfo* blockInfo)
         : DeclarativeEnvironmentRecord()
@@ -572,6 +574,8 @@ class DeclarativeEnvironmentRecordNotIndexed : public DeclarativeEnvironmentReco
 #ifdef ESCARGOT_DEBUGGER
     friend class Debugger;
 #endif /* ESCARGOT_DEBUGGER */
+    friend class HeapSnapshot;
+
 public:
     DeclarativeEnvironmentRecordNotIndexed(ExecutionState& state, bool isVarDeclarationTarget = false, bool isCatchClause = false)
         : DeclarativeEnvironmentRecord()
@@ -883,12 +887,11 @@ public:
         RELEASE_ASSERT_NOT_REACHED();
     }
 
-#ifdef ESCARGOT_DEBUGGER
+    // used by debugger and heap snapshot
     virtual IdentifierRecordVector* getRecordVector()
     {
         return NULL;
     }
-#endif /* ESCARGOT_DEBUGGER */
 
 private:
     // ArgumentsObject is constructed on EnsureArgumentsObject opcode
@@ -1093,12 +1096,10 @@ public:
         return EnvironmentRecord::BindingSlot(this, SIZE_MAX, false);
     }
 
-#ifdef ESCARGOT_DEBUGGER
-    virtual IdentifierRecordVector* getRecordVector()
+    virtual IdentifierRecordVector* getRecordVector() override
     {
         return &m_recordVector;
     }
-#endif /* ESCARGOT_DEBUGGER */
 
     virtual void createBinding(ExecutionState& state, const AtomicString& name, bool canDelete = false, bool isMutable = true, bool isVarDeclaration = true, Optional<InterpretedCodeBlock*> relatedCodeBlock = nullptr) override;
     virtual EnvironmentRecord::GetBindingValueResult getBindingValue(ExecutionState& state, const AtomicString& name) override;
@@ -1125,6 +1126,8 @@ class ModuleEnvironmentRecord : public DeclarativeEnvironmentRecord {
 #ifdef ESCARGOT_DEBUGGER
     friend class Debugger;
 #endif /* ESCARGOT_DEBUGGER */
+    friend class HeapSnapshot;
+
 public:
     struct ModuleBindingRecord {
         bool m_isMutable;
@@ -1133,6 +1136,8 @@ public:
         EncodedValue m_value;
         ModuleEnvironmentRecord* m_targetRecord;
         AtomicString m_targetBindingName;
+        // index of target binding in m_targetRecord (resolved on linking)
+        size_t m_targetBindingIndex;
     };
 
     typedef Vector<ModuleBindingRecord, GCUtil::gc_malloc_allocator<ModuleBindingRecord>> ModuleBindingRecordVector;
@@ -1200,6 +1205,8 @@ protected:
         return m_moduleBindings;
     }
 
+    Value getImportedBindingValue(ExecutionState& state, const size_t i);
+
     void readCheck(ExecutionState& state, const size_t i)
     {
         if (UNLIKELY(m_moduleBindings[i].m_value.isEmpty())) {
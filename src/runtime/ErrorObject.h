@@ -179,6 +179,8 @@ public:
         };
     };
     struct StackTraceNonGCData {
+        // infoString is function name of native function frame
+        static constexpr size_t NativeFunctionFramePosition = SIZE_MAX - 1;
         size_t byteCodePosition;
     };
     struct StackTraceData : public gc {
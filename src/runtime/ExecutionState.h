@@ -79,6 +79,7 @@ public:
         , m_onTry(false)
         , m_onCatch(false)
         , m_onFinally(false)
+        , m_hasPendingException(false)
         , m_argc(0)
         , m_argv(nullptr)
     {
@@ -105,6 +106,7 @@ public:
         , m_onTry(false)
         , m_onCatch(false)
         , m_onFinally(false)
+        , m_hasPendingException(false)
         , m_argc(parent->argc())
         , m_argv(parent->argv())
     {
@@ -123,6 +125,7 @@ public:
         , m_onTry(false)
         , m_onCatch(false)
         , m_onFinally(false)
+        , m_hasPendingException(false)
         , m_argc(0)
         , m_argv(nullptr)
     {
@@ -141,6 +144,7 @@ public:
         , m_onTry(false)
         , m_onCatch(false)
         , m_onFinally(false)
+        , m_hasPendingException(false)
         , m_argc(argc)
         , m_argv(argv)
     {
@@ -159,6 +163,7 @@ public:
         , m_onTry(false)
         , m_onCatch(false)
         , m_onFinally(false)
+        , m_hasPendingException(false)
         , m_argc(argc)
         , m_argv(argv)
     {
@@ -180,6 +185,7 @@ public:
         , m_onTry(false)
         , m_onCatch(false)
         , m_onFinally(false)
+        , m_hasPendingException(false)
         , m_argc(argc)
         , m_argv(argv)
     {
@@ -345,6 +351,8 @@ private:
     bool m_onTry : 1;
     bool m_onCatch : 1;
     bool m_onFinally : 1;
+    // set when ThrowOperation passed its exception to the enclosing try block without C++ unwinding
+    bool m_hasPendingException : 1;
 #ifdef ESCARGOT_32
     size_t m_argc : 24;
 #else
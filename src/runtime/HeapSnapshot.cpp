@@ -0,0 +1,391 @@
+/*
+ * Copyright (c) 2016-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "HeapSnapshot.h"
+#include "runtime/ProfilerOutput.h"
+#include "runtime/Context.h"
+#include "runtime/GlobalObject.h"
+#include "runtime/ArrayObject.h"
+#include "runtime/MapObject.h"
+#include "runtime/SetObject.h"
+#include "runtime/BoundFunctionObject.h"
+#include "runtime/ScriptFunctionObject.h"
+#include "runtime/Environment.h"
+#include "runtime/EnvironmentRecord.h"
+#include "runtime/StringView.h"
+#include "runtime/RopeString.h"
+#include "runtime/Symbol.h"
+
+#ifndef HEAP_SNAPSHOT_STRING_LENGTH_LIMIT
+#define HEAP_SNAPSHOT_STRING_LENGTH_LIMIT 1024
+#endif
+
+namespace Escargot {
+
+HeapSnapshot::HeapSnapshot(ExecutionState& state)
+    : m_state(state)
+{
+    addString(std::string());
+}
+
+size_t HeapSnapshot::allocatedSize(void* ptr)
+{
+    void* base = ptr ? GC_base(ptr) : nullptr;
+    return base ? GC_size(base) : 0;
+}
+
+size_t HeapSnapshot::addString(const std::string& str)
+{
+    auto iter = m_stringIndex.find(str);
+    if (iter != m_stringIndex.end()) {
+        return iter->second;
+    }
+    size_t index = m_strings.size();
+    m_strings.push_back(str);
+    m_stringIndex.insert(std::make_pair(str, index));
+    return index;
+}
+
+size_t HeapSnapshot::addString(String* str)
+{
+    // taking a snapshot should not change the heap
+    // so pieces of rope string are read one by one without flattening it
+    std::string result;
+    size_t remain = HEAP_SNAPSHOT_STRING_LENGTH_LIMIT;
+    std::vector<String*> stack;
+    stack.push_back(str);
+    while (!stack.empty() && remain) {
+        String* piece = stack.back();
+        stack.pop_back();
+        if (piece->isRopeString() && !piece->asRopeString()->wasFlattened()) {
+            stack.push_back(piece->asRopeString()->right());
+            stack.push_back(piece->asRopeString()->left());
+        } else if (piece->length() > remain) {
+            StringView view(piece, 0, remain);
+            result += view.toNonGCUTF8StringData();
+            remain = 0;
+        } else {
+            result += piece->toNonGCUTF8StringData();
+            remain -= piece->length();
+        }
+    }
+    return addString(result);
+}
+
+size_t HeapSnapshot::addNode(NodeKind kind, NodeType type, void* pointer, size_t name, size_t selfSize)
+{
+    size_t index = m_nodes.size();
+    m_nodes.push_back(Node({ kind, type, pointer, name, selfSize, 0 }));
+    if (pointer) {
+        m_nodeIndex.insert(std::make_pair(pointer, index));
+    }
+    return index;
+}
+
+uint64_t HeapSnapshot::nodeId(size_t index)
+{
+    // ids of JavaScript objects are odd numbers in V8
+    // heap of bdwgc is not moving, so address of cell keeps identity of object
+    // between snapshots while the object is alive. devtools compares snapshots by id
+    // synthetic roots have small ids which cannot be a cell address
+    void* pointer = m_nodes[index].m_pointer;
+    if (!pointer) {
+        return index * 2 + 1;
+    }
+    return (uint64_t)(size_t)pointer / sizeof(void*) * 2 + 1;
+}
+
+void HeapSnapshot::addEdge(size_t from, EdgeType type, size_t nameOrIndex, size_t to)
+{
+    m_edges.push_back(Edge({ type, nameOrIndex, to }));
+    m_nodes[from].m_edgeCount++;
+}
+
+void HeapSnapshot::addValueEdge(size_t from, EdgeType type, size_t nameOrIndex, const Value& value)
+{
+    // primitive values are stored in the slot. there is nothing to follow
+    if (value.isPointerValue()) {
+        addEdge(from, type, nameOrIndex, nodeForPointerValue(value.asPointerValue()));
+    }
+}
+
+String* HeapSnapshot::classNameOf(Object* object)
+{
+    // find constructor of prototype chain without calling any user code
+    AtomicString constructor = m_state.context()->staticStrings().constructor;
+    Object* o = object->rawInternalPrototypeObject().unwrap();
+    while (o) {
+        auto result = o->structure()->findProperty(constructor);
+        if (result.first != SIZE_MAX) {
+            if (result.second->m_descriptor.isPlainDataProperty()) {
+                Value c = o->m_values[result.first];
+                if (c.isObject() && c.asObject()->isFunctionObject()) {
+                    String* name = c.asObject()->asFunctionObject()->codeBlock()->functionName().string();
+                    if (name->length()) {
+                        return name;
+                    }
+                }
+            }
+            break;
+        }
+        o = o->rawInternalPrototypeObject().unwrap();
+    }
+
+    return m_state.context()->staticStrings().Object.string();
+}
+
+size_t HeapSnapshot::nodeForPointerValue(PointerValue* value)
+{
+    auto iter = m_nodeIndex.find(value);
+    if (iter != m_nodeIndex.end()) {
+        return iter->second;
+    }
+
+    if (value->isString()) {
+        String* str = value->asString();
+        return addNode(PointerValueKind, str->isRopeString() ? ConcatenatedStringNode : StringNode, value, addString(str), allocatedSize(value));
+    } else if (value->isSymbol()) {
+        Optional<String*> description = value->asSymbol()->description();
+        return addNode(PointerValueKind, SymbolNode, value, description ? addString(description.value()) : 0, allocatedSize(value));
+    } else if (value->isBigInt()) {
+        return addNode(PointerValueKind, BigIntNode, value, addString("bigint"), allocatedSize(value));
+    } else if (value->isObject()) {
+        Object* object = value->asObject();
+        // properties and fast elements are counted as self size of object
+        size_t selfSize = allocatedSize(object) + allocatedSize(object->m_values.data());
+        if (object->isArrayObject()) {
+            selfSize += allocatedSize(*reinterpret_cast<void**>(&object->asArrayObject()->m_fastModeData));
+        }
+
+        if (object->isFunctionObject()) {
+            String* name = object->asFunctionObject()->codeBlock()->functionName().string();
+            return addNode(PointerValueKind, ClosureNode, value, name->length() ? addString(name) : addString("(anonymous)"), selfSize);
+        }
+        return addNode(PointerValueKind, object->isRegExpObject() ? RegExpNode : ObjectNode, value, addString(classNameOf(object)), selfSize);
+    }
+
+    return addNode(PointerValueKind, HiddenNode, value, addString("system / PointerValue"), allocatedSize(value));
+}
+
+size_t HeapSnapshot::nodeForEnvironment(LexicalEnvironment* env)
+{
+    auto iter = m_nodeIndex.find(env);
+    if (iter != m_nodeIndex.end()) {
+        return iter->second;
+    }
+    return addNode(EnvironmentKind, HiddenNode, env, addString("system / Context"), allocatedSize(env) + allocatedSize(env->record()));
+}
+
+size_t HeapSnapshot::nodeForStructure(ObjectStructure* structure)
+{
+    auto iter = m_nodeIndex.find(structure);
+    if (iter != m_nodeIndex.end()) {
+        return iter->second;
+    }
+    return addNode(StructureKind, HiddenNode, structure, addString("system / ObjectStructure"), allocatedSize(structure));
+}
+
+void HeapSnapshot::visitObject(size_t index, Object* object)
+{
+    ObjectStructure* structure = object->structure();
+    addEdge(index, InternalEdge, addString("map"), nodeForStructure(structure));
+    if (object->rawInternalPrototypeObject()) {
+        addEdge(index, PropertyEdge, addString("__proto__"), nodeForPointerValue(object->rawInternalPrototypeObject().value()));
+    }
+
+    size_t count = structure->propertyCount();
+    for (size_t i = 0; i < count; i++) {
+        const ObjectStructureItem& item = structure->readProperty(i);
+        Value slot = object->m_values[i];
+        String* name = item.m_propertyName.toExceptionString();
+        if (item.m_descriptor.isDataProperty()) {
+            addValueEdge(index, PropertyEdge, addString(name), slot);
+        } else {
+            JSGetterSetter* gs = slot.asPointerValue()->asJSGetterSetter();
+            if (gs->hasGetter()) {
+                addValueEdge(index, PropertyEdge, addString("get " + name->toNonGCUTF8StringData()), gs->getter());
+            }
+            if (gs->hasSetter()) {
+                addValueEdge(index, PropertyEdge, addString("set " + name->toNonGCUTF8StringData()), gs->setter());
+            }
+        }
+    }
+
+    if (object->isArrayObject() && object->asArrayObject()->isFastModeArray()) {
+        ArrayObject* array = object->asArrayObject();
+        size_t length = array->arrayLength(m_state);
+        for (size_t i = 0; i < length; i++) {
+            addValueEdge(index, ElementEdge, i, array->getFastModeValue(i));
+        }
+    } else if (object->isMapObject()) {
+        const MapObject::MapObjectData& storage = object->asMapObject()->storage();
+        for (size_t i = 0; i < storage.size(); i++) {
+            if (!storage[i].first.isEmpty()) {
+                addValueEdge(index, InternalEdge, addString("key"), storage[i].first);
+                addValueEdge(index, InternalEdge, addString("value"), storage[i].second);
+            }
+        }
+    } else if (object->isSetObject()) {
+        const SetObject::SetObjectData& storage = object->asSetObject()->storage();
+        for (size_t i = 0; i < storage.size(); i++) {
+            if (!storage[i].isEmpty()) {
+                addValueEdge(index, InternalEdge, addString("value"), storage[i]);
+            }
+        }
+    } else if (object->isBoundFunctionObject()) {
+        addValueEdge(index, InternalEdge, addString("bound_function"), object->asBoundFunctionObject()->targetFunction());
+    } else if (object->isScriptFunctionObject()) {
+        LexicalEnvironment* env = object->asScriptFunctionObject()->outerEnvironment();
+        // global scope is reachable from root
+        if (env && !env->record()->isGlobalEnvironmentRecord()) {
+            addEdge(index, InternalEdge, addString("context"), nodeForEnvironment(env));
+        }
+    }
+}
+
+void HeapSnapshot::visitBinding(size_t index, EnvironmentRecord* record, const AtomicString& name)
+{
+    try {
+        EnvironmentRecord::GetBindingValueResult result = record->getBindingValue(m_state, name);
+        if (result.m_hasBindingValue) {
+            addValueEdge(index, ContextEdge, addString(name.string()), result.m_value);
+        }
+    } catch (const Value& val) {
+        // binding is in TDZ
+    }
+}
+
+void HeapSnapshot::visitEnvironment(size_t index, LexicalEnvironment* env)
+{
+    EnvironmentRecord* record = env->record();
+    if (record->isObjectEnvironmentRecord()) {
+        addEdge(index, InternalEdge, addString("with"), nodeForPointerValue(record->asObjectEnvironmentRecord()->bindingObject()));
+    } else if (record->isModuleEnvironmentRecord()) {
+        const ModuleEnvironmentRecord::ModuleBindingRecordVector& bindings = record->asModuleEnvironmentRecord()->moduleBindings();
+        for (size_t i = 0; i < bindings.size(); i++) {
+            visitBinding(index, record, bindings[i].m_localName);
+        }
+    } else if (record->isDeclarativeEnvironmentRecord()) {
+        DeclarativeEnvironmentRecord* declarativeRecord = record->asDeclarativeEnvironmentRecord();
+        if (declarativeRecord->isFunctionEnvironmentRecord()) {
+            FunctionEnvironmentRecord* functionRecord = declarativeRecord->asFunctionEnvironmentRecord();
+            IdentifierRecordVector* recordVector = functionRecord->getRecordVector();
+            if (recordVector) {
+                for (size_t i = 0; i < recordVector->size(); i++) {
+                    visitBinding(index, record, (*recordVector)[i].m_name);
+                }
+            } else if (functionRecord->isFunctionEnvironmentRecordOnHeap()) {
+                const InterpretedCodeBlock::IdentifierInfoVector& infos = functionRecord->functionObject()->interpretedCodeBlock()->identifierInfos();
+                for (size_t i = 0; i < infos.size(); i++) {
+                    if (!infos[i].m_needToAllocateOnStack) {
+                        visitBinding(index, record, infos[i].m_name);
+                    }
+                }
+            }
+            addEdge(index, InternalEdge, addString("closure"), nodeForPointerValue(functionRecord->functionObject()));
+        } else if (declarativeRecord->isDeclarativeEnvironmentRecordNotIndexed()) {
+            IdentifierRecordVector& recordVector = declarativeRecord->asDeclarativeEnvironmentRecordNotIndexed()->m_recordVector;
+            for (size_t i = 0; i < recordVector.size(); i++) {
+                visitBinding(index, record, recordVector[i].m_name);
+            }
+        } else if (declarativeRecord->isDeclarativeEnvironmentRecordIndexed()) {
+            const auto& identifiers = declarativeRecord->asDeclarativeEnvironmentRecordIndexed()->m_blockInfo->m_identifiers;
+            for (size_t i = 0; i < identifiers.size(); i++) {
+                if (!identifiers[i].m_needToAllocateOnStack) {
+                    visitBinding(index, record, identifiers[i].m_name);
+                }
+            }
+        }
+    }
+
+    LexicalEnvironment* outer = env->outerEnvironment();
+    if (outer && !outer->record()->isGlobalEnvironmentRecord()) {
+        addEdge(index, InternalEdge, addString("previous"), nodeForEnvironment(outer));
+    }
+}
+
+void HeapSnapshot::build()
+{
+    Context* context = m_state.context();
+
+    size_t root = addNode(SyntheticKind, SyntheticNode, nullptr, 0, 0);
+    size_t lexicalScope = addNode(SyntheticKind, SyntheticNode, nullptr, addString("(Global lexical scope)"), 0);
+    addEdge(root, ShortcutEdge, addString("globalThis"), nodeForPointerValue(context->globalObject()));
+    addEdge(root, InternalEdge, addString("lexical"), lexicalScope);
+
+    // edges of each node should be added while the node is visited
+    // so nodes are visited in order of creation
+    for (size_t i = 0; i < m_nodes.size(); i++) {
+        if (i == lexicalScope) {
+            IdentifierRecordVector* records = context->globalDeclarativeRecord();
+            EncodedValueVector* storage = context->globalDeclarativeStorage();
+            for (size_t j = 0; j < records->size() && j < storage->size(); j++) {
+                addValueEdge(i, ContextEdge, addString((*records)[j].m_name.string()), (*storage)[j]);
+            }
+        } else if (m_nodes[i].m_kind == PointerValueKind && ((PointerValue*)m_nodes[i].m_pointer)->isObject()) {
+            visitObject(i, ((PointerValue*)m_nodes[i].m_pointer)->asObject());
+        } else if (m_nodes[i].m_kind == EnvironmentKind) {
+            visitEnvironment(i, (LexicalEnvironment*)m_nodes[i].m_pointer);
+        }
+    }
+}
+
+bool HeapSnapshot::writeTo(const char* path)
+{
+    const size_t nodeFieldCount = 6;
+    std::string out = "{\"snapshot\":{\"meta\":{"
+                      "\"node_fields\":[\"type\",\"name\",\"id\",\"self_size\",\"edge_count\",\"trace_node_id\"],"
+                      "\"node_types\":[[\"hidden\",\"array\",\"string\",\"object\",\"code\",\"closure\",\"regexp\",\"number\",\"native\",\"synthetic\",\"concatenated string\",\"sliced string\",\"symbol\",\"bigint\"],\"string\",\"number\",\"number\",\"number\",\"number\"],"
+                      "\"edge_fields\":[\"type\",\"name_or_index\",\"to_node\"],"
+                      "\"edge_types\":[[\"context\",\"element\",\"property\",\"internal\",\"hidden\",\"shortcut\",\"weak\"],\"string_or_number\",\"node\"],"
+                      "\"trace_function_info_fields\":[],\"trace_node_fields\":[],\"sample_fields\":[],\"location_fields\":[]},";
+    out += "\"node_count\":" + std::to_string(m_nodes.size()) + ",\"edge_count\":" + std::to_string(m_edges.size()) + ",\"trace_function_count\":0},";
+
+    out += "\"nodes\":[";
+    for (size_t i = 0; i < m_nodes.size(); i++) {
+        const Node& node = m_nodes[i];
+        if (i) {
+            out += ',';
+        }
+        out += std::to_string(node.m_type) + ',' + std::to_string(node.m_name) + ',' + std::to_string(nodeId(i)) + ','
+            + std::to_string(node.m_selfSize) + ',' + std::to_string(node.m_edgeCount) + ",0";
+    }
+
+    out += "],\"edges\":[";
+    for (size_t i = 0; i < m_edges.size(); i++) {
+        const Edge& edge = m_edges[i];
+        if (i) {
+            out += ',';
+        }
+        out += std::to_string(edge.m_type) + ',' + std::to_string(edge.m_nameOrIndex) + ',' + std::to_string(edge.m_to * nodeFieldCount);
+    }
+
+    out += "],\"trace_function_infos\":[],\"trace_tree\":[],\"samples\":[],\"locations\":[],\"strings\":[";
+    for (size_t i = 0; i < m_strings.size(); i++) {
+        if (i) {
+            out += ',';
+        }
+        ProfilerOutput::appendJSONString(out, m_strings[i]);
+    }
+    out += "]}";
+
+    return ProfilerOutput::writeFile(path, out);
+}
+} // namespace Escargot
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2016-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotHeapSnapshot__
+#define __EscargotHeapSnapshot__
+
+namespace Escargot {
+
+class ExecutionState;
+class Object;
+class String;
+class AtomicString;
+class LexicalEnvironment;
+class EnvironmentRecord;
+class ObjectStructure;
+class PointerValue;
+class Value;
+
+// builds object graph reachable from roots of a Context
+// and writes it as Chrome DevTools .heapsnapshot json
+// graph is built from object properties, elements and closure scopes
+// bdwgc scans conservatively, so native references are not part of the graph
+class HeapSnapshot {
+public:
+    explicit HeapSnapshot(ExecutionState& state);
+
+    void build();
+    bool writeTo(const char* path);
+
+private:
+    // same order with node_types and edge_types of .heapsnapshot meta
+    enum NodeType {
+        HiddenNode,
+        ArrayNode,
+        StringNode,
+        ObjectNode,
+        CodeNode,
+        ClosureNode,
+        RegExpNode,
+        NumberNode,
+        NativeNode,
+        SyntheticNode,
+        ConcatenatedStringNode,
+        SlicedStringNode,
+        SymbolNode,
+        BigIntNode,
+    };
+
+    enum EdgeType {
+        ContextEdge,
+        ElementEdge,
+        PropertyEdge,
+        InternalEdge,
+        HiddenEdge,
+        ShortcutEdge,
+        WeakEdge,
+    };
+
+    enum NodeKind {
+        SyntheticKind,
+        PointerValueKind,
+        EnvironmentKind,
+        StructureKind,
+    };
+
+    struct Node {
+        NodeKind m_kind;
+        NodeType m_type;
+        void* m_pointer;
+        size_t m_name;
+        size_t m_selfSize;
+        size_t m_edgeCount;
+    };
+
+    struct Edge {
+        EdgeType m_type;
+        // index of strings or element index
+        size_t m_nameOrIndex;
+        size_t m_to;
+    };
+
+    size_t addString(const std::string& str);
+    size_t addString(String* str);
+    size_t addNode(NodeKind kind, NodeType type, void* pointer, size_t name, size_t selfSize);
+    void addEdge(size_t from, EdgeType type, size_t nameOrIndex, size_t to);
+    uint64_t nodeId(size_t index);
+    void addValueEdge(size_t from, EdgeType type, size_t nameOrIndex, const Value& value);
+
+    size_t nodeForPointerValue(PointerValue* value);
+    size_t nodeForEnvironment(LexicalEnvironment* env);
+    size_t nodeForStructure(ObjectStructure* structure);
+    String* classNameOf(Object* object);
+
+    void visitObject(size_t index, Object* object);
+    void visitEnvironment(size_t index, LexicalEnvironment* env);
+    void visitBinding(size_t index, EnvironmentRecord* record, const AtomicString& name);
+
+    static size_t allocatedSize(void* ptr);
+
+    ExecutionState& m_state;
+    std::vector<Node> m_nodes;
+    // edges of each node are stored contiguously in order of nodes
+    std::vector<Edge> m_edges;
+    std::unordered_map<void*, size_t> m_nodeIndex;
+    std::vector<std::string> m_strings;
+    std::unordered_map<std::string, size_t> m_stringIndex;
+};
+} // namespace Escargot
+
+#endif
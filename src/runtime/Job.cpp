@@ -22,6 +22,7 @@
 #include "Context.h"
 #include "VMInstance.h"
 #include "SandBox.h"
+#include "runtime/ExecutionPauser.h"
 #include "runtime/FinalizationRegistryObject.h"
 
 namespace Escargot {
@@ -52,6 +53,18 @@ SandBox::SandBoxResult PromiseReactionJob::run()
     // https://www.ecma-international.org/ecma-262/10.0/#sec-promisereactionjob
     SandBox sandbox(context);
     SandBox::SandBoxResult result = sandbox.run([&]() -> Value {
+        // await reaction of async function
+        // http://www.ecma-international.org/ecma-262/10.0/#await-fulfilled
+        // http://www.ecma-international.org/ecma-262/10.0/#await-rejected
+        if (m_reaction.m_awaitPauser) {
+            ExecutionPauser* pauser = m_reaction.m_awaitPauser;
+            Object* source = pauser->sourceObject();
+            // Resume the suspended evaluation of asyncContext using NormalCompletion(value) or ThrowCompletion(reason)
+            ExecutionPauser::start(state, pauser, source, m_argument, false, m_reaction.m_handler == (Object*)2,
+                                   source->isAsyncGeneratorObject() ? ExecutionPauser::StartFrom::AsyncGenerator : ExecutionPauser::StartFrom::Async);
+            return Value();
+        }
+
         /* 25.4.2.1.4 Handler is "Identity" case */
         if (m_reaction.m_handler == (Object*)1) {
             Value value[] = { m_argument };
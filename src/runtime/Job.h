@@ -38,12 +38,22 @@ public:
         return m_relatedContext;
     }
 
+    virtual bool isPromiseReactionJob() const
+    {
+        return false;
+    }
+
 protected:
     Job(Context* relatedContext)
         : m_relatedContext(relatedContext)
     {
     }
 
+    void setRelatedContext(Context* relatedContext)
+    {
+        m_relatedContext = relatedContext;
+    }
+
 private:
     Context* m_relatedContext;
 };
@@ -60,6 +70,24 @@ public:
 
     SandBox::SandBoxResult run();
 
+    virtual bool isPromiseReactionJob() const override
+    {
+        return true;
+    }
+
+    // JobQueue recycles PromiseReactionJob after run
+    void reset(Context* relatedContext, const PromiseReaction& reaction, const Value& argument)
+    {
+        setRelatedContext(relatedContext);
+        m_reaction = reaction;
+        m_argument = argument;
+    }
+
+    void clear()
+    {
+        reset(nullptr, PromiseReaction(), Value());
+    }
+
 private:
     PromiseReaction m_reaction;
     Value m_argument;
@@ -26,20 +26,82 @@
 
 namespace Escargot {
 
+JobQueue::JobQueue()
+    : m_head(new Segment())
+    , m_spareSegment(nullptr)
+    , m_headIndex(0)
+    , m_tailIndex(0)
+    , m_size(0)
+    , m_currentDrainJobCount(0)
+{
+    m_tail = m_head;
+}
+
 void JobQueue::enqueueJob(Job* job)
 {
-    m_jobs.push_back(job);
+    if (m_tailIndex == JOB_QUEUE_SEGMENT_SIZE) {
+        Segment* segment = m_spareSegment;
+        if (segment) {
+            m_spareSegment = nullptr;
+        } else {
+            segment = new Segment();
+        }
+        m_tail->m_next = segment;
+        m_tail = segment;
+        m_tailIndex = 0;
+    }
+
+    m_tail->m_jobs[m_tailIndex++] = job;
+    m_size++;
+
+    if (m_size > m_statistics.m_peakPendingJobCount) {
+        m_statistics.m_peakPendingJobCount = m_size;
+    }
+}
+
+void JobQueue::didRunJob(Job* job)
+{
+    m_statistics.m_executedJobCount++;
+    m_currentDrainJobCount++;
+    if (!m_size) {
+        m_statistics.m_drainCount++;
+        m_statistics.m_lastDrainJobCount = m_currentDrainJobCount;
+        if (m_currentDrainJobCount > m_statistics.m_maxDrainJobCount) {
+            m_statistics.m_maxDrainJobCount = m_currentDrainJobCount;
+        }
+        m_currentDrainJobCount = 0;
+    }
+
+    if (job->isPromiseReactionJob() && m_promiseReactionJobPool.size() < JOB_QUEUE_PROMISE_REACTION_JOB_POOL_SIZE) {
+        PromiseReactionJob* reactionJob = static_cast<PromiseReactionJob*>(job);
+        reactionJob->clear();
+        m_promiseReactionJobPool.pushBack(reactionJob);
+    }
+}
+
+PromiseReactionJob* JobQueue::newPromiseReactionJob(Context* relatedContext, const PromiseReaction& reaction, const Value& argument)
+{
+    if (m_promiseReactionJobPool.size()) {
+        PromiseReactionJob* job = m_promiseReactionJobPool.back();
+        m_promiseReactionJobPool.pop_back();
+        job->reset(relatedContext, reaction, argument);
+        return job;
+    }
+    return new PromiseReactionJob(relatedContext, reaction, argument);
 }
 
 void JobQueue::clearJobRelatedWithSpecificContext(Context* context)
 {
-    auto iter = m_jobs.begin();
-    while (iter != m_jobs.end()) {
-        if ((*iter)->relatedContext() == context) {
-            iter = m_jobs.erase(iter);
-        } else {
-            iter++;
+    Vector<Job*, GCUtil::gc_malloc_allocator<Job*>> remainJobs;
+    while (hasNextJob()) {
+        Job* job = nextJob();
+        if (job->relatedContext() != context) {
+            remainJobs.pushBack(job);
         }
     }
+
+    for (size_t i = 0; i < remainJobs.size(); i++) {
+        enqueueJob(remainJobs[i]);
+    }
 }
 } // namespace Escargot
@@ -26,26 +26,107 @@ namespace Escargot {
 
 class ExecutionState;
 
+#ifndef JOB_QUEUE_SEGMENT_SIZE
+#define JOB_QUEUE_SEGMENT_SIZE 128
+#endif
+
+#ifndef JOB_QUEUE_PROMISE_REACTION_JOB_POOL_SIZE
+#define JOB_QUEUE_PROMISE_REACTION_JOB_POOL_SIZE 64
+#endif
+
+// jobs are stored in fixed-size segments linked as a queue
+// drained segment is kept as spare and queue rewinds to the first slot when it becomes empty,
+// so enqueue does not allocate in steady state
 class JobQueue : public gc {
 public:
-    JobQueue() {}
+    struct Statistics {
+        Statistics()
+            : m_peakPendingJobCount(0)
+            , m_executedJobCount(0)
+            , m_drainCount(0)
+            , m_lastDrainJobCount(0)
+            , m_maxDrainJobCount(0)
+        {
+        }
+
+        size_t m_peakPendingJobCount;
+        size_t m_executedJobCount;
+        size_t m_drainCount; // number of times the queue became empty after running jobs
+        size_t m_lastDrainJobCount;
+        size_t m_maxDrainJobCount;
+    };
+
+    JobQueue();
     void enqueueJob(Job* job);
     void clearJobRelatedWithSpecificContext(Context* context);
     bool hasNextJob()
     {
-        return !m_jobs.empty();
+        return m_size;
     }
 
     Job* nextJob()
     {
-        ASSERT(!m_jobs.empty());
-        Job* job = m_jobs.front();
-        m_jobs.pop_front();
+        ASSERT(m_size);
+        if (m_headIndex == JOB_QUEUE_SEGMENT_SIZE) {
+            Segment* drained = m_head;
+            m_head = drained->m_next;
+            m_headIndex = 0;
+            drained->m_next = nullptr;
+            m_spareSegment = drained;
+        }
+
+        Job* job = m_head->m_jobs[m_headIndex];
+        m_head->m_jobs[m_headIndex++] = nullptr;
+        m_size--;
+
+        if (!m_size) {
+            ASSERT(m_head == m_tail && m_headIndex == m_tailIndex);
+            m_headIndex = m_tailIndex = 0;
+        }
         return job;
     }
 
+    // should be called after running job returned from nextJob
+    void didRunJob(Job* job);
+
+    // reuses PromiseReactionJob which already ran
+    PromiseReactionJob* newPromiseReactionJob(Context* relatedContext, const PromiseReaction& reaction, const Value& argument);
+
+    size_t pendingJobCount() const
+    {
+        return m_size;
+    }
+
+    const Statistics& statistics() const
+    {
+        return m_statistics;
+    }
+
+    void resetStatistics()
+    {
+        m_statistics = Statistics();
+    }
+
 private:
-    std::list<Job*, gc_allocator<Job*>> m_jobs;
+    struct Segment : public gc {
+        Segment()
+            : m_next(nullptr)
+        {
+        }
+
+        Segment* m_next;
+        Job* m_jobs[JOB_QUEUE_SEGMENT_SIZE];
+    };
+
+    Segment* m_head;
+    Segment* m_tail;
+    Segment* m_spareSegment;
+    size_t m_headIndex;
+    size_t m_tailIndex;
+    size_t m_size;
+    size_t m_currentDrainJobCount;
+    Statistics m_statistics;
+    Vector<PromiseReactionJob*, GCUtil::gc_malloc_allocator<PromiseReactionJob*>> m_promiseReactionJobPool;
 };
 } // namespace Escargot
 #endif // __EscargotJobQueue__
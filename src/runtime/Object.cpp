@@ -32,6 +32,9 @@
 #include "BigIntObject.h"
 #include "ProxyObject.h"
 #include "ScriptClassConstructorFunctionObject.h"
+#if defined(ENABLE_SAMPLING_PROFILER)
+#include "SamplingProfiler.h"
+#endif
 
 namespace Escargot {
 
@@ -456,12 +459,25 @@ void ObjectPropertyDescriptor::completePropertyDescriptor(ObjectPropertyDescript
     // 8. Return Desc.
 }
 
+#if defined(ENABLE_SAMPLING_PROFILER)
+#define SAMPLE_OBJECT_ALLOCATION(state)                                                  \
+    {                                                                                    \
+        AllocationSampler* sampler = state.context()->vmInstance()->allocationSampler(); \
+        if (UNLIKELY(sampler != nullptr)) {                                              \
+            sampler->didAllocateObject(state, this);                                     \
+        }                                                                                \
+    }
+#else
+#define SAMPLE_OBJECT_ALLOCATION(state)
+#endif
+
 Object::Object(ExecutionState& state)
     : m_structure(state.context()->defaultStructureForObject())
     , m_prototype(state.context()->globalObject()->objectPrototype())
 {
     ASSERT(!!m_prototype);
     m_values.resizeWithUninitializedValues(0, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER);
+    SAMPLE_OBJECT_ALLOCATION(state);
 }
 
 // https://www.ecma-international.org/ecma-262/10.0/#sec-objectcreate
@@ -474,6 +490,7 @@ Object::Object(ExecutionState& state, Object* proto)
     ASSERT(proto->hasRareData() && proto->rareData()->m_isEverSetAsPrototypeObject);
     // create a new ordinary object
     m_values.resizeWithUninitializedValues(0, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER);
+    SAMPLE_OBJECT_ALLOCATION(state);
 }
 
 Object::Object(ExecutionState& state, Object::PrototypeIsNullTag)
@@ -482,6 +499,7 @@ Object::Object(ExecutionState& state, Object::PrototypeIsNullTag)
 {
     // create a new ordinary object
     m_values.resizeWithUninitializedValues(0, ESCARGOT_OBJECT_BUILTIN_PROPERTY_NUMBER);
+    SAMPLE_OBJECT_ALLOCATION(state);
 }
 
 Object::Object(ExecutionState& state, Object* proto, size_t defaultSpace)
@@ -492,6 +510,7 @@ Object::Object(ExecutionState& state, Object* proto, size_t defaultSpace)
     ASSERT(!!proto);
     ASSERT(proto->hasRareData() && proto->rareData()->m_isEverSetAsPrototypeObject);
     m_values.resizeWithUninitializedValues(0, defaultSpace);
+    SAMPLE_OBJECT_ALLOCATION(state);
 }
 
 // this constructor is used only for initialization of GlobalObject
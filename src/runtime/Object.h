@@ -771,6 +771,9 @@ class Object : public PointerValue {
     friend struct ObjectRareData;
     friend class Template;
     friend class ObjectTemplate;
+    friend class Global;
+    friend class JSONStringifyContext;
+    friend class HeapSnapshot;
 
 public:
     explicit Object(ExecutionState& state);
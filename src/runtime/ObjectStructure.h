@@ -28,6 +28,7 @@
 namespace Escargot {
 
 class ObjectStructure;
+struct EnumerateObjectKeyCache;
 
 struct ObjectStructureItem : public gc {
     ObjectStructureItem(const ObjectStructurePropertyName& as, const ObjectStructurePropertyDescriptor& desc)
@@ -137,6 +138,17 @@ public:
 
     virtual bool inTransitionMode() = 0;
     virtual bool hasIndexPropertyName() = 0;
+
+    // key list of for-in memoized by EnumerateObjectWithIteration
+    // only transition-mode structure keeps it
+    virtual EnumerateObjectKeyCache* enumerateObjectKeyCache()
+    {
+        return nullptr;
+    }
+
+    virtual void setEnumerateObjectKeyCache(EnumerateObjectKeyCache* cache)
+    {
+    }
 };
 
 class ObjectStructureWithoutTransition : public ObjectStructure {
@@ -186,6 +198,7 @@ public:
         , m_transitionTableVectorBufferSize(0)
         , m_transitionTableVectorBufferCapacity(0)
         , m_transitionTableVectorBuffer(nullptr)
+        , m_enumerateObjectKeyCache(nullptr)
     {
     }
 
@@ -208,6 +221,16 @@ public:
         return m_hasIndexPropertyName;
     }
 
+    virtual EnumerateObjectKeyCache* enumerateObjectKeyCache() override
+    {
+        return m_enumerateObjectKeyCache;
+    }
+
+    virtual void setEnumerateObjectKeyCache(EnumerateObjectKeyCache* cache) override
+    {
+        m_enumerateObjectKeyCache = cache;
+    }
+
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
 
@@ -233,10 +256,12 @@ private:
         ObjectStructureTransitionVectorItem* m_transitionTableVectorBuffer;
         ObjectStructureTransitionTableMap* m_transitionTableMap;
     };
+
+    EnumerateObjectKeyCache* m_enumerateObjectKeyCache;
 };
 
 COMPILE_ASSERT(ESCARGOT_OBJECT_STRUCTURE_TRANSITION_MAP_MIN_SIZE <= 32, "");
-COMPILE_ASSERT(sizeof(ObjectStructureWithTransition) == sizeof(size_t) * 5, "");
+COMPILE_ASSERT(sizeof(ObjectStructureWithTransition) == sizeof(size_t) * 6, "");
 
 class ObjectStructureWithMap : public ObjectStructure {
 public:
@@ -115,6 +115,7 @@ class PointerValue : public gc {
 
     // tag values for fast type check
     // these values actually have unique virtual table address of each object class
+    static size_t g_objectTag;
     static size_t g_arrayObjectTag;
     static size_t g_arrayPrototypeObjectTag;
     static size_t g_objectRareDataTag;
@@ -143,6 +144,12 @@ public:
         return getTagInFirstDataArea() & POINTER_VALUE_BIGINT_TAG_IN_DATA;
     }
 
+    // true only for instance of Object class itself (object literal, new Object, Object.prototype...)
+    inline bool isPlainObject() const
+    {
+        return hasTag(g_objectTag);
+    }
+
     inline bool isArrayObject() const
     {
         return hasTag(g_arrayObjectTag) || hasTag(g_arrayPrototypeObjectTag);
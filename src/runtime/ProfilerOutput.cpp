@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2016-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "Escargot.h"
+#include "ProfilerOutput.h"
+#include "runtime/String.h"
+
+namespace Escargot {
+
+void ProfilerOutput::appendJSONString(std::string& out, const char* str, size_t length)
+{
+    out += '"';
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = str[i];
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += c;
+        } else if (c < 0x20) {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += c;
+        }
+    }
+    out += '"';
+}
+
+void ProfilerOutput::appendJSONString(std::string& out, String* str)
+{
+    if (!str) {
+        out += "\"\"";
+        return;
+    }
+    UTF8StringDataNonGCStd s = str->toNonGCUTF8StringData();
+    appendJSONString(out, s.data(), s.length());
+}
+
+bool ProfilerOutput::writeFile(const char* path, const std::string& content)
+{
+    FILE* fp = fopen(path, "wb");
+    if (!fp) {
+        return false;
+    }
+    bool succeeded = fwrite(content.data(), 1, content.length(), fp) == content.length();
+    fclose(fp);
+    return succeeded;
+}
+} // namespace Escargot
@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2016-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotProfilerOutput__
+#define __EscargotProfilerOutput__
+
+namespace Escargot {
+
+class String;
+
+// shared by writers of heap snapshot, cpu profile and allocation samples
+// so every output escapes strings in the same way
+class ProfilerOutput {
+public:
+    // append utf-8 string as quoted JSON string
+    static void appendJSONString(std::string& out, const char* str, size_t length);
+    static void appendJSONString(std::string& out, const std::string& str)
+    {
+        appendJSONString(out, str.data(), str.length());
+    }
+    // nullptr is written as empty string
+    static void appendJSONString(std::string& out, String* str);
+
+    static bool writeFile(const char* path, const std::string& content);
+};
+} // namespace Escargot
+
+#endif
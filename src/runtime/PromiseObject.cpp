@@ -194,13 +194,11 @@ Optional<Object*> PromiseObject::then(ExecutionState& state, Value onFulfilledVa
         break;
     }
     case PromiseObject::PromiseState::FulFilled: {
-        Job* job = new PromiseReactionJob(state.context(), PromiseReaction(onFulfilled, capability), promiseResult());
-        state.context()->vmInstance()->enqueueJob(job);
+        state.context()->vmInstance()->enqueuePromiseReactionJob(state.context(), PromiseReaction(onFulfilled, capability), promiseResult());
         break;
     }
     case PromiseObject::PromiseState::Rejected: {
-        Job* job = new PromiseReactionJob(state.context(), PromiseReaction(onRejected, capability), promiseResult());
-        state.context()->vmInstance()->enqueueJob(job);
+        state.context()->vmInstance()->enqueuePromiseReactionJob(state.context(), PromiseReaction(onRejected, capability), promiseResult());
         break;
     }
     default:
@@ -214,10 +212,44 @@ Optional<Object*> PromiseObject::then(ExecutionState& state, Value onFulfilledVa
     }
 }
 
+PromiseReaction::Capability PromiseObject::awaitReactionCapability(ExecutionState& state)
+{
+    PromiseReaction::Capability capability;
+#ifdef ESCARGOT_DEBUGGER
+    if (state.context()->debugger() != nullptr && state.context()->debugger()->enabled()) {
+        capability.m_savedStackTrace = Debugger::saveStackTrace(state);
+    }
+#endif /* ESCARGOT_DEBUGGER */
+    return capability;
+}
+
+void PromiseObject::thenForAwait(ExecutionState& state, ExecutionPauser* awaitPauser)
+{
+    PromiseReaction::Capability capability = awaitReactionCapability(state);
+
+    switch (this->state()) {
+    case PromiseObject::PromiseState::Pending: {
+        m_fulfillReactions.push_back(PromiseReaction(awaitPauser, false, capability));
+        m_rejectReactions.push_back(PromiseReaction(awaitPauser, true, capability));
+        break;
+    }
+    case PromiseObject::PromiseState::FulFilled: {
+        state.context()->vmInstance()->enqueuePromiseReactionJob(state.context(), PromiseReaction(awaitPauser, false, capability), promiseResult());
+        break;
+    }
+    case PromiseObject::PromiseState::Rejected: {
+        state.context()->vmInstance()->enqueuePromiseReactionJob(state.context(), PromiseReaction(awaitPauser, true, capability), promiseResult());
+        break;
+    }
+    default:
+        break;
+    }
+}
+
 void PromiseObject::triggerPromiseReactions(ExecutionState& state, PromiseObject::Reactions& reactions)
 {
     for (size_t i = 0; i < reactions.size(); i++) {
-        state.context()->vmInstance()->enqueueJob(new PromiseReactionJob(state.context(), reactions[i], m_promiseResult));
+        state.context()->vmInstance()->enqueuePromiseReactionJob(state.context(), reactions[i], m_promiseResult);
     }
 }
 
@@ -26,6 +26,7 @@
 namespace Escargot {
 
 class PromiseObject;
+class ExecutionPauser;
 
 struct PromiseReaction {
 public:
@@ -62,18 +63,30 @@ public:
     PromiseReaction()
         : m_capability()
         , m_handler(nullptr)
+        , m_awaitPauser(nullptr)
     {
     }
 
     PromiseReaction(Object* handler, const Capability& capability)
         : m_capability(capability)
         , m_handler(handler)
+        , m_awaitPauser(nullptr)
     {
     }
 
+    // reaction of await in async function
+    // PromiseReactionJob resumes the pauser directly instead of calling Await Fulfilled/Rejected Functions
+    // handler is Identity(1) for fulfill reaction and Thrower(2) for reject reaction
+    PromiseReaction(ExecutionPauser* awaitPauser, bool isRejectReaction, const Capability& capability)
+        : m_capability(capability)
+        , m_handler(isRejectReaction ? (Object*)2 : (Object*)1)
+        , m_awaitPauser(awaitPauser)
+    {
+    }
 
     Capability m_capability;
     Object* m_handler;
+    ExecutionPauser* m_awaitPauser;
 };
 
 class PromiseObject : public Object {
@@ -134,6 +147,9 @@ public:
     // http://www.ecma-international.org/ecma-262/10.0/#sec-performpromisethen
     // You can get return value when you give resultCapability
     Optional<Object*> then(ExecutionState& state, Value onFulfilled, Value onRejected, Optional<PromiseReaction::Capability> resultCapability = Optional<PromiseReaction::Capability>());
+    // PerformPromiseThen of await without allocating onFulfilled, onRejected functions
+    void thenForAwait(ExecutionState& state, ExecutionPauser* awaitPauser);
+    static PromiseReaction::Capability awaitReactionCapability(ExecutionState& state);
 
     void* operator new(size_t size);
     void* operator new[](size_t size) = delete;
@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2016-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#if defined(ENABLE_SAMPLING_PROFILER)
+
+#include "Escargot.h"
+#include "SamplingProfiler.h"
+#include "runtime/ProfilerOutput.h"
+#include "runtime/SandBox.h"
+#include "runtime/ExecutionState.h"
+#include "interpreter/ByteCode.h"
+#include "parser/CodeBlock.h"
+#include "parser/Script.h"
+
+namespace Escargot {
+
+size_t SampledByteCodeBlocks::indexOf(ByteCodeBlock* block)
+{
+    auto iter = m_index.find(block);
+    if (iter != m_index.end()) {
+        return iter->second;
+    }
+
+    size_t index = m_blocks.size();
+    m_blocks.pushBack(block);
+    m_index.insert(std::make_pair(block, index));
+    return index;
+}
+
+SamplingProfiler::SamplingProfiler(std::atomic<bool>* sampleRequested, size_t intervalInMicroseconds)
+    : m_sampleRequested(sampleRequested)
+    , m_intervalInMicroseconds(std::max(intervalInMicroseconds, (size_t)1))
+    , m_startTime(currentTimeInMicroseconds())
+    , m_lastSampleTime(m_startTime)
+    , m_truncatedFunctionName(String::fromASCII("(truncated)"))
+    , m_terminate(false)
+{
+    // root node
+    m_nodes.pushBack(Node({ SIZE_MAX, SIZE_MAX, SIZE_MAX, nullptr, nullptr, String::emptyString, String::emptyString, 0 }));
+    m_thread = std::thread(&SamplingProfiler::timerMain, this);
+}
+
+SamplingProfiler::~SamplingProfiler()
+{
+    stop();
+}
+
+void SamplingProfiler::stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(m_mutex);
+        m_terminate = true;
+    }
+    m_condition.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    m_sampleRequested->store(false, std::memory_order_relaxed);
+}
+
+void SamplingProfiler::timerMain()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    while (!m_terminate) {
+        m_condition.wait_for(lock, std::chrono::microseconds(m_intervalInMicroseconds));
+        if (!m_terminate) {
+            m_sampleRequested->store(true, std::memory_order_relaxed);
+        }
+    }
+}
+
+uint64_t SamplingProfiler::currentTimeInMicroseconds()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+size_t SamplingProfiler::findOrAddChild(size_t parent, void* key, InterpretedCodeBlock* codeBlock, String* functionName, String* src)
+{
+    size_t child = m_nodes[parent].m_firstChild;
+    while (child != SIZE_MAX) {
+        if (m_nodes[child].m_key == key) {
+            return child;
+        }
+        child = m_nodes[child].m_nextSibling;
+    }
+
+    size_t index = m_nodes.size();
+    m_nodes.pushBack(Node({ parent, SIZE_MAX, m_nodes[parent].m_firstChild, key, codeBlock, functionName, src, 0 }));
+    m_nodes[parent].m_firstChild = index;
+    return index;
+}
+
+void SamplingProfiler::takeSample(ExecutionState& state)
+{
+    m_sampleRequested->store(false, std::memory_order_relaxed);
+
+    uint64_t now = currentTimeInMicroseconds();
+    SandBox::StackTraceDataVector stackTraceData;
+    // one more frame is collected to know whether the stack is cut or not
+    SandBox::createStackTraceData(stackTraceData, state, false, SAMPLING_PROFILER_STACK_DEPTH_LIMIT + 1);
+
+    size_t node = 0;
+    size_t depth = stackTraceData.size();
+    if (UNLIKELY(depth > SAMPLING_PROFILER_STACK_DEPTH_LIMIT)) {
+        // callers of truncated stack are unknown. the profiler itself is used as key of synthetic node
+        depth = SAMPLING_PROFILER_STACK_DEPTH_LIMIT;
+        node = findOrAddChild(node, this, nullptr, m_truncatedFunctionName, String::emptyString);
+    }
+
+    // stack trace data is ordered from callee to caller
+    for (size_t i = depth; i > 0; i--) {
+        const SandBox::StackTraceData& data = stackTraceData[i - 1].second;
+        if (data.loc.byteCodePosition != SIZE_MAX) {
+            InterpretedCodeBlock* codeBlock = data.loc.actualCodeBlock->m_codeBlock;
+            node = findOrAddChild(node, codeBlock, codeBlock, data.functionName, data.src);
+        } else if (data.isNativeFunctionFrame()) {
+            node = findOrAddChild(node, data.functionName, nullptr, data.functionName, String::emptyString);
+        } else {
+            node = findOrAddChild(node, data.src, nullptr, data.functionName, data.src);
+        }
+    }
+
+    m_nodes[node].m_hitCount++;
+    if (stackTraceData.size() && stackTraceData[0].second.loc.byteCodePosition != SIZE_MAX) {
+        const ExtendedNodeLOC& loc = stackTraceData[0].second.loc;
+        m_positionHits[std::make_tuple(node, m_byteCodeBlocks.indexOf(loc.actualCodeBlock), loc.byteCodePosition)]++;
+    }
+
+    if (LIKELY(m_samples.size() < SAMPLING_PROFILER_SAMPLE_COUNT_LIMIT)) {
+        m_samples.push_back(node);
+        m_timeDeltas.push_back(now - m_lastSampleTime);
+        m_lastSampleTime = now;
+    }
+}
+
+bool SamplingProfiler::writeCPUProfile(const char* path)
+{
+    // resolve bytecode positions of top frames into lines
+    std::vector<std::map<size_t, size_t>> lineHits(m_nodes.size());
+    for (auto& hit : m_positionHits) {
+        size_t node = std::get<0>(hit.first);
+        ByteCodeBlock* block = m_byteCodeBlocks.at(std::get<1>(hit.first));
+        InterpretedCodeBlock* codeBlock = block->m_codeBlock;
+        if (!codeBlock->script()) {
+            continue;
+        }
+        ExtendedNodeLOC loc = block->computeNodeLOCFromByteCode(codeBlock->context(), std::get<2>(hit.first), codeBlock);
+        if (loc.line != SIZE_MAX) {
+            lineHits[node][loc.line] += hit.second;
+        }
+    }
+
+    std::unordered_map<Script*, size_t> scriptIds;
+    std::string out = "{\"nodes\":[";
+    for (size_t i = 0; i < m_nodes.size(); i++) {
+        const Node& node = m_nodes[i];
+        InterpretedCodeBlock* codeBlock = node.m_codeBlock;
+        size_t scriptId = 0;
+        int64_t lineNumber = -1;
+        int64_t columnNumber = -1;
+        if (codeBlock && codeBlock->script()) {
+            scriptId = scriptIds.insert(std::make_pair(codeBlock->script(), scriptIds.size() + 1)).first->second;
+            // ExtendedNodeLOC is 1-based but cpuprofile expects 0-based one
+            lineNumber = (int64_t)codeBlock->functionStart().line - 1;
+            columnNumber = (int64_t)codeBlock->functionStart().column - 1;
+        }
+
+        if (i) {
+            out += ',';
+        }
+        out += "{\"id\":" + std::to_string(i + 1) + ",\"callFrame\":{\"functionName\":";
+        if (i == 0) {
+            out += "\"(root)\"";
+        } else if (node.m_functionName->length() == 0) {
+            out += "\"(anonymous)\"";
+        } else {
+            ProfilerOutput::appendJSONString(out, node.m_functionName);
+        }
+        out += ",\"scriptId\":\"" + std::to_string(scriptId) + "\",\"url\":";
+        ProfilerOutput::appendJSONString(out, node.m_src);
+        out += ",\"lineNumber\":" + std::to_string(lineNumber) + ",\"columnNumber\":" + std::to_string(columnNumber) + "}";
+        out += ",\"hitCount\":" + std::to_string(node.m_hitCount);
+
+        if (node.m_firstChild != SIZE_MAX) {
+            out += ",\"children\":[";
+            for (size_t child = node.m_firstChild; child != SIZE_MAX; child = m_nodes[child].m_nextSibling) {
+                out += std::to_string(child + 1);
+                if (m_nodes[child].m_nextSibling != SIZE_MAX) {
+                    out += ',';
+                }
+            }
+            out += ']';
+        }
+
+        if (lineHits[i].size()) {
+            out += ",\"positionTicks\":[";
+            bool first = true;
+            for (auto& lineHit : lineHits[i]) {
+                if (!first) {
+                    out += ',';
+                }
+                first = false;
+                out += "{\"line\":" + std::to_string(lineHit.first) + ",\"ticks\":" + std::to_string(lineHit.second) + "}";
+            }
+            out += ']';
+        }
+        out += '}';
+    }
+
+    out += "],\"startTime\":" + std::to_string(m_startTime) + ",\"endTime\":" + std::to_string(m_lastSampleTime) + ",\"samples\":[";
+    for (size_t i = 0; i < m_samples.size(); i++) {
+        if (i) {
+            out += ',';
+        }
+        out += std::to_string(m_samples[i] + 1);
+    }
+    out += "],\"timeDeltas\":[";
+    for (size_t i = 0; i < m_timeDeltas.size(); i++) {
+        if (i) {
+            out += ',';
+        }
+        out += std::to_string(m_timeDeltas[i]);
+    }
+    out += "]}";
+
+    return ProfilerOutput::writeFile(path, out);
+}
+
+AllocationSampler::AllocationSampler(size_t sampleInterval)
+    : m_sampleInterval(std::max(sampleInterval, (size_t)1))
+    , m_countdown(m_sampleInterval)
+    , m_nativeSite({ 0, 0 })
+{
+}
+
+void AllocationSampler::takeSample(ExecutionState& state, Object* object)
+{
+    // object is allocated already but not constructed yet
+    void* base = GC_base(object);
+    size_t size = base ? GC_size(base) : 0;
+
+    SandBox::StackTraceDataVector stackTraceData;
+    SandBox::createStackTraceData(stackTraceData, state, false, SAMPLING_PROFILER_STACK_DEPTH_LIMIT);
+
+    // allocation from native function is accounted to the nearest JavaScript caller
+    for (size_t i = 0; i < stackTraceData.size(); i++) {
+        const ExtendedNodeLOC& loc = stackTraceData[i].second.loc;
+        if (loc.byteCodePosition != SIZE_MAX) {
+            Site& site = m_sites[std::make_pair(m_byteCodeBlocks.indexOf(loc.actualCodeBlock), loc.byteCodePosition)];
+            site.m_count++;
+            site.m_size += size;
+            return;
+        }
+    }
+
+    m_nativeSite.m_count++;
+    m_nativeSite.m_size += size;
+}
+
+bool AllocationSampler::writeAllocationProfile(const char* path)
+{
+    struct ResolvedSite {
+        InterpretedCodeBlock* m_codeBlock;
+        size_t m_line;
+        size_t m_column;
+        Site m_site;
+    };
+
+    // sites of same line are merged
+    std::map<std::tuple<InterpretedCodeBlock*, size_t, size_t>, Site> resolvedSites;
+    for (auto& site : m_sites) {
+        ByteCodeBlock* block = m_byteCodeBlocks.at(site.first.first);
+        InterpretedCodeBlock* codeBlock = block->m_codeBlock;
+        ExtendedNodeLOC loc(SIZE_MAX, SIZE_MAX, SIZE_MAX);
+        if (codeBlock->script()) {
+            loc = block->computeNodeLOCFromByteCode(codeBlock->context(), site.first.second, codeBlock);
+        }
+        Site& merged = resolvedSites[std::make_tuple(codeBlock, loc.line, loc.column)];
+        merged.m_count += site.second.m_count;
+        merged.m_size += site.second.m_size;
+    }
+
+    std::vector<ResolvedSite> sites;
+    for (auto& site : resolvedSites) {
+        sites.push_back(ResolvedSite({ std::get<0>(site.first), std::get<1>(site.first), std::get<2>(site.first), site.second }));
+    }
+    std::sort(sites.begin(), sites.end(), [](const ResolvedSite& a, const ResolvedSite& b) {
+        return a.m_site.m_size > b.m_site.m_size;
+    });
+
+    std::string out = "{\"sampleInterval\":" + std::to_string(m_sampleInterval) + ",\"sites\":[";
+    for (size_t i = 0; i < sites.size(); i++) {
+        const ResolvedSite& site = sites[i];
+        if (i) {
+            out += ',';
+        }
+        String* functionName = site.m_codeBlock->functionName().string();
+        out += "{\"functionName\":";
+        if (functionName->length()) {
+            ProfilerOutput::appendJSONString(out, functionName);
+        } else {
+            out += "\"(anonymous)\"";
+        }
+        out += ",\"url\":";
+        ProfilerOutput::appendJSONString(out, site.m_codeBlock->script() ? site.m_codeBlock->script()->srcName() : String::emptyString);
+        // line and column are 1-based. -1 when the position is unknown
+        out += ",\"line\":" + std::to_string(site.m_line == SIZE_MAX ? -1 : (int64_t)site.m_line);
+        out += ",\"column\":" + std::to_string(site.m_column == SIZE_MAX ? -1 : (int64_t)site.m_column);
+        out += ",\"count\":" + std::to_string(site.m_site.m_count) + ",\"size\":" + std::to_string(site.m_site.m_size) + "}";
+    }
+    out += "],\"native\":{\"count\":" + std::to_string(m_nativeSite.m_count) + ",\"size\":" + std::to_string(m_nativeSite.m_size) + "}}";
+
+    return ProfilerOutput::writeFile(path, out);
+}
+} // namespace Escargot
+
+#endif
@@ -0,0 +1,141 @@
+/*
+ * Copyright (c) 2016-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#ifndef __EscargotSamplingProfiler__
+#define __EscargotSamplingProfiler__
+
+#if defined(ENABLE_SAMPLING_PROFILER)
+
+#include "util/Vector.h"
+
+namespace Escargot {
+
+class ExecutionState;
+class ByteCodeBlock;
+class InterpretedCodeBlock;
+class String;
+class Object;
+
+// keeps sampled ByteCodeBlocks alive and gives them stable indexes
+// so bytecode positions can be resolved into lines after sampling
+class SampledByteCodeBlocks {
+public:
+    size_t indexOf(ByteCodeBlock* block);
+    ByteCodeBlock* at(size_t index)
+    {
+        return m_blocks[index];
+    }
+
+private:
+    Vector<ByteCodeBlock*, GCUtil::gc_malloc_allocator<ByteCodeBlock*>> m_blocks;
+    std::unordered_map<ByteCodeBlock*, size_t> m_index;
+};
+
+// samples JavaScript stack of VMInstance periodically
+// timer thread only raises the request flag of VMInstance
+// and the interpreter takes a sample on its own thread at back-edges and function entries
+// frames deeper than SAMPLING_PROFILER_STACK_DEPTH_LIMIT are cut and the rest is put under "(truncated)" node
+// after SAMPLING_PROFILER_SAMPLE_COUNT_LIMIT samples, hit counts are still updated but the timeline stops growing
+class SamplingProfiler : public gc {
+public:
+    SamplingProfiler(std::atomic<bool>* sampleRequested, size_t intervalInMicroseconds);
+    ~SamplingProfiler();
+
+    NEVER_INLINE void takeSample(ExecutionState& state);
+
+    // stop timer thread. collected samples are kept
+    void stop();
+    // write collected samples as Chrome DevTools .cpuprofile json
+    bool writeCPUProfile(const char* path);
+
+private:
+    struct Node {
+        size_t m_parent;
+        size_t m_firstChild;
+        size_t m_nextSibling;
+        // identity of frame. InterpretedCodeBlock for JavaScript frame, function name or source name otherwise
+        void* m_key;
+        InterpretedCodeBlock* m_codeBlock;
+        String* m_functionName;
+        String* m_src;
+        size_t m_hitCount;
+    };
+
+    void timerMain();
+    size_t findOrAddChild(size_t parent, void* key, InterpretedCodeBlock* codeBlock, String* functionName, String* src);
+    static uint64_t currentTimeInMicroseconds();
+
+    std::atomic<bool>* m_sampleRequested;
+    size_t m_intervalInMicroseconds;
+    uint64_t m_startTime;
+    uint64_t m_lastSampleTime;
+
+    // nodes and blocks are kept alive until profiler is destroyed
+    Vector<Node, GCUtil::gc_malloc_allocator<Node>> m_nodes;
+    SampledByteCodeBlocks m_byteCodeBlocks;
+    // (node, byteCodeBlock index, bytecode position) of top frame -> hit count
+    std::map<std::tuple<size_t, size_t, size_t>, size_t> m_positionHits;
+    std::vector<size_t> m_samples;
+    std::vector<uint64_t> m_timeDeltas;
+    String* m_truncatedFunctionName;
+
+    bool m_terminate;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::thread m_thread;
+};
+
+// records allocating bytecode position of every `sampleInterval`th object allocation
+class AllocationSampler : public gc {
+public:
+    explicit AllocationSampler(size_t sampleInterval);
+
+    void didAllocateObject(ExecutionState& state, Object* object)
+    {
+        if (LIKELY(--m_countdown)) {
+            return;
+        }
+        m_countdown = m_sampleInterval;
+        takeSample(state, object);
+    }
+
+    // write sampled allocation sites as json ordered by sampled size
+    bool writeAllocationProfile(const char* path);
+
+private:
+    NEVER_INLINE void takeSample(ExecutionState& state, Object* object);
+
+    struct Site {
+        size_t m_count;
+        size_t m_size;
+    };
+
+    size_t m_sampleInterval;
+    size_t m_countdown;
+    SampledByteCodeBlocks m_byteCodeBlocks;
+    // (byteCodeBlock index, bytecode position) -> sampled allocations
+    std::map<std::pair<size_t, size_t>, Site> m_sites;
+    // allocations without JavaScript frame (e.g. from native code of embedder)
+    Site m_nativeSite;
+};
+} // namespace Escargot
+
+#endif
+
+#endif
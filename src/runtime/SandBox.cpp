@@ -66,23 +66,13 @@ void SandBox::processCatch(const Value& error, SandBoxResult& result)
     }
 #endif /* ESCARGOT_DEBUGGER */
 
-    ByteCodeLOCDataMap locMap;
     for (size_t i = 0; i < m_stackTraceData.size(); i++) {
         if ((size_t)m_stackTraceData[i].second.loc.index == SIZE_MAX && (size_t)m_stackTraceData[i].second.loc.actualCodeBlock != SIZE_MAX) {
             // this means loc not computed yet.
             ByteCodeBlock* block = m_stackTraceData[i].second.loc.actualCodeBlock;
 
-            ByteCodeLOCData* locData;
-            auto iterMap = locMap.find(block);
-            if (iterMap == locMap.end()) {
-                locData = new ByteCodeLOCData();
-                locMap.insert(std::make_pair(block, locData));
-            } else {
-                locData = iterMap->second;
-            }
-
             ExtendedNodeLOC loc = block->computeNodeLOCFromByteCode(m_context,
-                                                                    m_stackTraceData[i].second.loc.byteCodePosition, block->m_codeBlock, locData);
+                                                                    m_stackTraceData[i].second.loc.byteCodePosition, block->m_codeBlock);
 
             StackTraceData traceData;
             traceData.loc = loc;
@@ -104,12 +94,11 @@ void SandBox::processCatch(const Value& error, SandBoxResult& result)
             }
 #endif /* ESCARGOT_DEBUGGER */
         } else {
-            result.stackTraceData.pushBack(m_stackTraceData[i].second);
+            StackTraceData traceData = m_stackTraceData[i].second;
+            traceData.src = traceData.srcOrNativeFunctionInfo();
+            result.stackTraceData.pushBack(traceData);
         }
     }
-    for (auto iter = locMap.begin(); iter != locMap.end(); iter++) {
-        delete iter->second;
-    }
 }
 
 SandBox::SandBoxResult SandBox::run(Value (*scriptRunner)(ExecutionState&, void*), void* data)
@@ -136,10 +125,23 @@ SandBox::SandBoxResult SandBox::run(const std::function<Value()>& scriptRunner)
     return result;
 }
 
-bool SandBox::createStackTraceData(StackTraceDataVector& stackTraceData, ExecutionState& state, bool stopAtPause)
+String* SandBox::StackTraceData::nativeFunctionInfo(String* functionName)
+{
+    StringBuilder builder;
+    builder.appendString("function ");
+    builder.appendString(functionName);
+    builder.appendString("() { ");
+    builder.appendString("[native function]");
+    builder.appendString(" } ");
+    return builder.finalize();
+}
+
+bool SandBox::createStackTraceData(StackTraceDataVector& stackTraceData, ExecutionState& state, bool stopAtPause, size_t depthLimit)
 {
     UNUSED_VARIABLE(stopAtPause);
 
+    // data from previous throw (rethrow case)
+    const size_t existingDataCount = stackTraceData.size();
     ExecutionState* pstate = &state;
 #ifdef ESCARGOT_DEBUGGER
     uint32_t executionStateDepthIndex = 0;
@@ -150,7 +152,7 @@ bool SandBox::createStackTraceData(StackTraceDataVector& stackTraceData, Executi
     }
 #endif /* ESCARGOT_DEBUGGER */
 
-    while (pstate) {
+    while (pstate && stackTraceData.size() < depthLimit) {
         FunctionObject* callee = pstate->resolveCallee();
         ExecutionState* es = pstate;
 
@@ -174,10 +176,16 @@ bool SandBox::createStackTraceData(StackTraceDataVector& stackTraceData, Executi
 
         bool alreadyExists = false;
 
-        for (size_t i = 0; i < stackTraceData.size(); i++) {
+        // states are visited from callee to caller
+        // so data added by this walk can be duplicated with the last one only
+        if (stackTraceData.size() > existingDataCount) {
+            ExecutionState* last = stackTraceData.back().first;
+            alreadyExists = last == es || last->lexicalEnvironment() == es->lexicalEnvironment();
+        }
+
+        for (size_t i = 0; !alreadyExists && i < existingDataCount; i++) {
             if (stackTraceData[i].first == es || stackTraceData[i].first->lexicalEnvironment() == es->lexicalEnvironment()) {
                 alreadyExists = true;
-                break;
             }
         }
 
@@ -246,15 +254,15 @@ bool SandBox::createStackTraceData(StackTraceDataVector& stackTraceData, Executi
                     data.src = cb->asInterpretedCodeBlock()->script()->srcName();
 #ifdef ESCARGOT_DEBUGGER
                     data.executionStateDepth = executionStateDepthIndex;
+#endif /* ESCARGOT_DEBUGGER */
+                } else if (cb->isInterpretedCodeBlock()) {
+                    data.src = StackTraceData::nativeFunctionInfo(cb->functionName().string());
+#ifdef ESCARGOT_DEBUGGER
+                    data.executionStateDepth = executionStateDepthIndex;
 #endif /* ESCARGOT_DEBUGGER */
                 } else {
-                    StringBuilder builder;
-                    builder.appendString("function ");
-                    builder.appendString(cb->functionName().string());
-                    builder.appendString("() { ");
-                    builder.appendString("[native function]");
-                    builder.appendString(" } ");
-                    data.src = builder.finalize();
+                    // built later by srcOrNativeFunctionInfo
+                    data.src = String::emptyString;
 #ifdef ESCARGOT_DEBUGGER
                     data.executionStateDepth = executionStateDepthIndex;
 #endif /* ESCARGOT_DEBUGGER */
@@ -285,21 +293,26 @@ bool SandBox::createStackTraceData(StackTraceDataVector& stackTraceData, Executi
 }
 
 void SandBox::throwException(ExecutionState& state, Value exception)
+{
+    setPendingException(state, exception);
+    throw exception;
+}
+
+void SandBox::setPendingException(ExecutionState& state, Value exception)
 {
     m_stackTraceData.clear();
-    createStackTraceData(m_stackTraceData, state);
+    createStackTraceData(m_stackTraceData, state, false, m_context->vmInstance()->stackTraceDepthLimit());
 
     // We MUST save thrown exception Value.
     // because bdwgc cannot track `thrown value`(may turned off by GC_DONT_REGISTER_MAIN_STATIC_DATA)
     m_exception = exception;
-    throw exception;
 }
 
 void SandBox::rethrowPreviouslyCaughtException(ExecutionState& state, Value exception, const StackTraceDataVector& stackTraceData)
 {
     m_stackTraceData = stackTraceData;
     // update stack trace data if needs
-    createStackTraceData(m_stackTraceData, state);
+    createStackTraceData(m_stackTraceData, state, false, m_context->vmInstance()->stackTraceDepthLimit());
 
     // We MUST save thrown exception Value.
     // because bdwgc cannot track `thrown value`(may turned off by GC_DONT_REGISTER_MAIN_STATIC_DATA)
@@ -335,6 +348,9 @@ ErrorObject::StackTraceData* ErrorObject::StackTraceData::create(SandBox* sandBo
         if ((size_t)sandBox->m_stackTraceData[i].second.loc.index == SIZE_MAX && (size_t)sandBox->m_stackTraceData[i].second.loc.actualCodeBlock != SIZE_MAX) {
             data->gcValues[i].byteCodeBlock = sandBox->m_stackTraceData[i].second.loc.actualCodeBlock;
             data->nonGCValues[i].byteCodePosition = sandBox->m_stackTraceData[i].second.loc.byteCodePosition;
+        } else if (sandBox->m_stackTraceData[i].second.isNativeFunctionFrame()) {
+            data->gcValues[i].infoString = sandBox->m_stackTraceData[i].second.functionName;
+            data->nonGCValues[i].byteCodePosition = StackTraceNonGCData::NativeFunctionFramePosition;
         } else {
             data->gcValues[i].infoString = sandBox->m_stackTraceData[i].second.src;
             data->nonGCValues[i].byteCodePosition = SIZE_MAX;
@@ -364,25 +380,17 @@ void ErrorObject::StackTraceData::buildStackTrace(Context* context, StringBuilde
         });
     }
 
-    ByteCodeLOCDataMap locMap;
     for (size_t i = 0; i < gcValues.size(); i++) {
         builder.appendString("at ");
         if (nonGCValues[i].byteCodePosition == SIZE_MAX) {
             builder.appendString(gcValues[i].infoString);
+        } else if (nonGCValues[i].byteCodePosition == StackTraceNonGCData::NativeFunctionFramePosition) {
+            builder.appendString(SandBox::StackTraceData::nativeFunctionInfo(gcValues[i].infoString));
         } else {
             ByteCodeBlock* block = gcValues[i].byteCodeBlock;
 
-            ByteCodeLOCData* locData;
-            auto iterMap = locMap.find(block);
-            if (iterMap == locMap.end()) {
-                locData = new ByteCodeLOCData();
-                locMap.insert(std::make_pair(block, locData));
-            } else {
-                locData = iterMap->second;
-            }
-
             ExtendedNodeLOC loc = gcValues[i].byteCodeBlock->computeNodeLOCFromByteCode(context,
-                                                                                        nonGCValues[i].byteCodePosition, block->m_codeBlock, locData);
+                                                                                        nonGCValues[i].byteCodePosition, block->m_codeBlock);
 
             builder.appendString(block->m_codeBlock->script()->srcName());
             builder.appendChar(':');
@@ -443,9 +451,6 @@ void ErrorObject::StackTraceData::buildStackTrace(Context* context, StringBuilde
             builder.appendChar('\n');
         }
     }
-    for (auto iter = locMap.begin(); iter != locMap.end(); iter++) {
-        delete iter->second;
-    }
 }
 
 void SandBox::fillStackDataIntoErrorObject(const Value& e)
@@ -456,9 +461,11 @@ void SandBox::fillStackDataIntoErrorObject(const Value& e)
         obj->setStackTraceData(data);
 
         ExecutionState state(m_context);
-        JSGetterSetter gs(
-            new NativeFunctionObject(state, NativeFunctionInfo(m_context->staticStrings().stack, builtinErrorObjectStackInfo, 0, NativeFunctionInfo::Strict)),
-            Value(Value::EmptyValue));
+        // getter reads data from receiver, so it is shared in context
+        if (!m_context->m_errorStackGetter) {
+            m_context->m_errorStackGetter = new NativeFunctionObject(state, NativeFunctionInfo(m_context->staticStrings().stack, builtinErrorObjectStackInfo, 0, NativeFunctionInfo::Strict));
+        }
+        JSGetterSetter gs(m_context->m_errorStackGetter, Value(Value::EmptyValue));
         ObjectPropertyDescriptor desc(gs, ObjectPropertyDescriptor::ConfigurablePresent);
         obj->defineOwnProperty(state, ObjectPropertyName(m_context->staticStrings().stack), desc);
     }
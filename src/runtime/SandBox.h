@@ -59,6 +59,19 @@ public:
             , isEval(false)
         {
         }
+
+        bool isNativeFunctionFrame() const
+        {
+            return isFunction && !isAssociatedWithJavaScriptCode;
+        }
+
+        // src of native function frame is built only when it is requested
+        String* srcOrNativeFunctionInfo() const
+        {
+            return isNativeFunctionFrame() ? nativeFunctionInfo(functionName) : src;
+        }
+
+        static String* nativeFunctionInfo(String* functionName);
     };
 
     typedef Vector<std::pair<ExecutionState*, StackTraceData>, GCUtil::gc_malloc_allocator<std::pair<ExecutionState*, StackTraceData>>> StackTraceDataVector;
@@ -76,8 +89,10 @@ public:
 
     SandBoxResult run(const std::function<Value()>& scriptRunner); // for capsule script executing with try-catch
     SandBoxResult run(Value (*runner)(ExecutionState&, void*), void* data);
-    static bool createStackTraceData(StackTraceDataVector& stackTraceData, ExecutionState& state, bool stopAtPause = false);
+    static bool createStackTraceData(StackTraceDataVector& stackTraceData, ExecutionState& state, bool stopAtPause = false, size_t depthLimit = SIZE_MAX);
     void throwException(ExecutionState& state, Value exception);
+    // record exception and its stack trace same as throwException but do not throw it
+    void setPendingException(ExecutionState& state, Value exception);
     void rethrowPreviouslyCaughtException(ExecutionState& state, Value exception, const StackTraceDataVector& stackTraceData);
 
     StackTraceDataVector& stackTraceData()
@@ -22,6 +22,8 @@
 #include "runtime/Context.h"
 #include "runtime/FunctionObjectInlines.h"
 #include "runtime/PromiseObject.h"
+#include "runtime/ExecutionPauser.h"
+#include "runtime/VMInstance.h"
 
 namespace Escargot {
 
@@ -84,80 +86,25 @@ Value ScriptAsyncFunctionObject::construct(ExecutionState& state, const size_t a
     return Value();
 }
 
-class ScriptAsyncFunctionHelperFunctionObject : public NativeFunctionObject {
-public:
-    ScriptAsyncFunctionHelperFunctionObject(ExecutionState& state, NativeFunctionInfo info, ExecutionPauser* executionPauser, Object* source)
-        : NativeFunctionObject(state, info)
-        , m_executionPauser(executionPauser)
-        , m_source(source)
-    {
-    }
-
-    ExecutionPauser* m_executionPauser;
-    Object* m_source;
-};
-
-// http://www.ecma-international.org/ecma-262/10.0/#await-fulfilled
-static void awaitFulfilledFunctions(ExecutionState& state, ScriptAsyncFunctionHelperFunctionObject* F, const Value& value)
-{
-    // Let F be the active function object.
-    // Let asyncContext be F.[[AsyncContext]].
-    // Let prevContext be the running execution context.
-    // Suspend prevContext.
-    // Push asyncContext onto the execution context stack; asyncContext is now the running execution context.
-    // Resume the suspended evaluation of asyncContext using NormalCompletion(value) as the result of the operation that suspended it.
-    ExecutionPauser::start(state, F->m_executionPauser, F->m_source, value, false, false, F->m_source->isAsyncGeneratorObject() ? ExecutionPauser::StartFrom::AsyncGenerator : ExecutionPauser::StartFrom::Async);
-    // Assert: When we reach this step, asyncContext has already been removed from the execution context stack and prevContext is the currently running execution context.
-    // Return undefined.
-}
-
-static Value awaitFulfilledFunction(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
-{
-    ScriptAsyncFunctionHelperFunctionObject* self = (ScriptAsyncFunctionHelperFunctionObject*)state.resolveCallee();
-    awaitFulfilledFunctions(state, self, argv[0]);
-    return Value();
-}
-
-// http://www.ecma-international.org/ecma-262/10.0/#await-rejected
-static void awaitRejectedFunctions(ExecutionState& state, ScriptAsyncFunctionHelperFunctionObject* F, const Value& reason)
-{
-    // Let F be the active function object.
-    // Let asyncContext be F.[[AsyncContext]].
-    // Let prevContext be the running execution context.
-    // Suspend prevContext.
-    // Push asyncContext onto the execution context stack; asyncContext is now the running execution context.
-    // Resume the suspended evaluation of asyncContext using ThrowCompletion(reason) as the result of the operation that suspended it.
-    ExecutionPauser::start(state, F->m_executionPauser, F->m_source, reason, false, true, F->m_source->isAsyncGeneratorObject() ? ExecutionPauser::StartFrom::AsyncGenerator : ExecutionPauser::StartFrom::Async);
-    // Assert: When we reach this step, asyncContext has already been removed from the execution context stack and prevContext is the currently running execution context.
-    // Return undefined.
-}
-
-static Value awaitRejectedFunction(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
-{
-    ScriptAsyncFunctionHelperFunctionObject* self = (ScriptAsyncFunctionHelperFunctionObject*)state.resolveCallee();
-    awaitRejectedFunctions(state, self, argv[0]);
-    return Value();
-}
-
 // http://www.ecma-international.org/ecma-262/10.0/#await
-PromiseObject* ScriptAsyncFunctionObject::awaitOperationBeforePause(ExecutionState& state, ExecutionPauser* executionPauser, const Value& awaitValue, Object* source)
+// Await Fulfilled/Rejected Functions are not created
+// PromiseReactionJob resumes executionPauser directly with await reaction (see PromiseReaction)
+void ScriptAsyncFunctionObject::awaitOperationBeforePause(ExecutionState& state, ExecutionPauser* executionPauser, const Value& awaitValue, Object* source)
 {
+    ASSERT(executionPauser->sourceObject() == source);
+    VMInstance* vmInstance = state.context()->vmInstance();
+
+    // PromiseResolve(%Promise%, value) for non-object value is a new fulfilled promise which nobody can observe
+    // so reaction job can be queued without creating the promise
+    if (!awaitValue.isObject() && LIKELY(!vmInstance->isPromiseHookRegistered())) {
+        vmInstance->enqueuePromiseReactionJob(state.context(), PromiseReaction(executionPauser, false, PromiseObject::awaitReactionCapability(state)), awaitValue);
+        return;
+    }
+
     // Let asyncContext be the running execution context.
     // Let promise be ? PromiseResolve(%Promise%, « value »).
     PromiseObject* promise = PromiseObject::promiseResolve(state, state.context()->globalObject()->promise(), awaitValue)->asPromiseObject();
-    // Let stepsFulfilled be the algorithm steps defined in Await Fulfilled Functions.
-    // Let onFulfilled be CreateBuiltinFunction(stepsFulfilled, « [[AsyncContext]] »).
-    // Set onFulfilled.[[AsyncContext]] to asyncContext.
-    FunctionObject* onFulfilled = new ScriptAsyncFunctionHelperFunctionObject(state, NativeFunctionInfo(AtomicString(), awaitFulfilledFunction, 1), executionPauser, source);
-
-    // Let stepsRejected be the algorithm steps defined in Await Rejected Functions.
-    // Let onRejected be CreateBuiltinFunction(stepsRejected, « [[AsyncContext]] »).
-    // Set onRejected.[[AsyncContext]] to asyncContext.
-    FunctionObject* onRejected = new ScriptAsyncFunctionHelperFunctionObject(state, NativeFunctionInfo(AtomicString(), awaitRejectedFunction, 1), executionPauser, source);
-
     // Perform ! PerformPromiseThen(promise, onFulfilled, onRejected).
-    promise->then(state, onFulfilled, onRejected, Optional<PromiseReaction::Capability>());
-
-    return promise;
+    promise->thenForAwait(state, executionPauser);
 }
 } // namespace Escargot
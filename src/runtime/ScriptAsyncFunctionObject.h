@@ -59,7 +59,7 @@ public:
     virtual Value construct(ExecutionState& state, const size_t argc, Value* argv, Object* newTarget) override;
 
     // http://www.ecma-international.org/ecma-262/10.0/#await
-    static PromiseObject* awaitOperationBeforePause(ExecutionState& state, ExecutionPauser* pauser, const Value& awaitValue, Object* source);
+    static void awaitOperationBeforePause(ExecutionState& state, ExecutionPauser* pauser, const Value& awaitValue, Object* source);
 
 private:
     EncodedValue m_thisValue;
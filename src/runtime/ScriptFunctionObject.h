@@ -28,6 +28,7 @@ class ScriptFunctionObject : public FunctionObject {
     friend class Script;
     friend class ByteCodeInterpreter;
     friend class FunctionObjectProcessCallGenerator;
+    friend class HeapSnapshot;
 
 public:
     enum ConstructorKind {
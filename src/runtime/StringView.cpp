@@ -19,6 +19,7 @@
 
 #include "Escargot.h"
 #include "StringView.h"
+#include "CompressibleString.h"
 
 namespace Escargot {
 
@@ -34,4 +35,12 @@ void* StringView::operator new(size_t size)
     }
     return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
 }
+
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+StringBufferAccessData StringView::bufferAccessDataOfCompressibleString()
+{
+    // read only touched part of compressed string
+    return static_cast<CompressibleString*>(m_bufferData.bufferAsString)->bufferAccessDataOfRange(m_start, m_bufferData.length);
+}
+#endif
 } // namespace Escargot
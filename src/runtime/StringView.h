@@ -137,6 +137,11 @@ protected:
     virtual StringBufferAccessData bufferAccessDataSpecialImpl() override
     {
         ASSERT(m_bufferData.hasSpecialImpl);
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+        if (UNLIKELY(m_bufferData.bufferAsString->isCompressibleString())) {
+            return bufferAccessDataOfCompressibleString();
+        }
+#endif
 
         StringBufferAccessData r = m_bufferData.bufferAsString->bufferAccessData();
         // keep original buffer pointer in stack
@@ -162,6 +167,10 @@ protected:
     }
 
 private:
+#if defined(ENABLE_COMPRESSIBLE_STRING)
+    StringBufferAccessData bufferAccessDataOfCompressibleString();
+#endif
+
     size_t m_start;
 };
 } // namespace Escargot
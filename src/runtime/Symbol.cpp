@@ -28,25 +28,35 @@ Symbol* Symbol::fromGlobalSymbolRegistry(VMInstance* vm, String* stringKey)
 {
     // Let stringKey be ? ToString(key).
     // For each element e of the GlobalSymbolRegistry List,
-    auto& list = vm->globalSymbolRegistry();
-    for (size_t i = 0; i < list.size(); i++) {
+    auto& map = vm->globalSymbolRegistry();
+    auto iter = map.find(stringKey);
+    if (iter != map.end()) {
         // If SameValue(e.[[Key]], stringKey) is true, return e.[[Symbol]].
-        if (list[i].key->equals(stringKey)) {
-            return list[i].symbol;
-        }
+        return iter->second;
     }
     // Assert: GlobalSymbolRegistry does not currently contain an entry for stringKey.
     // Let newSymbol be a new unique Symbol value whose [[Description]] value is stringKey.
     Symbol* newSymbol = new Symbol(stringKey);
     // Append the Record { [[Key]]: stringKey, [[Symbol]]: newSymbol } to the GlobalSymbolRegistry List.
-    GlobalSymbolRegistryItem item;
-    item.key = stringKey;
-    item.symbol = newSymbol;
-    list.pushBack(item);
+    map.insert(std::make_pair(stringKey, newSymbol));
+    vm->globalSymbolRegistryReverseMap().insert(std::make_pair(newSymbol, stringKey));
     // Return newSymbol.
     return newSymbol;
 }
 
+Optional<String*> Symbol::keyForGlobalSymbolRegistry(VMInstance* vm, Symbol* sym)
+{
+    // For each element e of the GlobalSymbolRegistry List,
+    auto& map = vm->globalSymbolRegistryReverseMap();
+    auto iter = map.find(sym);
+    if (iter != map.end()) {
+        // If SameValue(e.[[Symbol]], sym) is true, return e.[[Key]].
+        return iter->second;
+    }
+    // Assert: GlobalSymbolRegistry does not currently contain an entry for sym.
+    return nullptr;
+}
+
 String* Symbol::symbolDescriptiveString() const
 {
     StringBuilder sb;
@@ -42,6 +42,8 @@ public:
     String* symbolDescriptiveString() const;
 
     static Symbol* fromGlobalSymbolRegistry(VMInstance* vm, String* stringKey);
+    // returns [[Key]] of sym if sym is in GlobalSymbolRegistry
+    static Optional<String*> keyForGlobalSymbolRegistry(VMInstance* vm, Symbol* sym);
 
 private:
     size_t m_tag;
@@ -146,6 +146,7 @@ void ThreadLocal::initialize()
     g_wasmContext.engine = wasm_engine_new();
     g_wasmContext.store = wasm_store_new(g_wasmContext.engine);
     g_wasmContext.lastGCCheckTime = 0;
+    g_wasmContext.callCountSinceGC = 0;
 #endif
 
     // g_gcEventListenerSet
@@ -194,6 +195,7 @@ void ThreadLocal::finalize()
     g_wasmContext.store = nullptr;
     g_wasmContext.engine = nullptr;
     g_wasmContext.lastGCCheckTime = 0;
+    g_wasmContext.callCountSinceGC = 0;
 #endif
 
     // g_gcEventListenerSet
@@ -218,6 +220,7 @@ void ThreadLocal::wasmGC(uint64_t lastCheckTime)
     ASSERT(inited && !!g_wasmContext.store);
     wasm_store_gc(g_wasmContext.store);
     g_wasmContext.lastGCCheckTime = lastCheckTime;
+    g_wasmContext.callCountSinceGC = 0;
 }
 #endif
 
@@ -31,6 +31,7 @@ struct WASMContext {
     wasm_engine_t* engine;
     wasm_store_t* store;
     uint64_t lastGCCheckTime;
+    size_t callCountSinceGC;
 };
 #endif
 
@@ -132,6 +133,13 @@ public:
         ASSERT(inited && !!g_wasmContext.store);
         return g_wasmContext.lastGCCheckTime;
     }
+
+    // count of wasm function calls since last wasmGC
+    static size_t& wasmCallCountSinceGC()
+    {
+        ASSERT(inited && !!g_wasmContext.store);
+        return g_wasmContext.callCountSinceGC;
+    }
 #endif
 
     static GCEventListenerSet& gcEventListenerSet()
@@ -57,9 +57,11 @@ public:
         return true;
     }
 
-    virtual TypedArrayType typedArrayType()
+    // typed array type is fixed at creation time
+    // so we can read it without virtual function call (used by interpreter fast path)
+    ALWAYS_INLINE TypedArrayType typedArrayType() const
     {
-        RELEASE_ASSERT_NOT_REACHED();
+        return m_typedArrayType;
     }
 
     virtual size_t elementSize()
@@ -84,8 +86,9 @@ public:
     static ArrayBuffer* validateTypedArray(ExecutionState& state, const Value& O);
 
 protected:
-    explicit TypedArrayObject(ExecutionState& state, Object* proto)
+    explicit TypedArrayObject(ExecutionState& state, Object* proto, TypedArrayType type)
         : ArrayBufferView(state, proto)
+        , m_typedArrayType(type)
     {
     }
 
@@ -93,6 +96,9 @@ protected:
     inline ObjectGetResult integerIndexedElementGet(ExecutionState& state, double index);
     // https://www.ecma-international.org/ecma-262/10.0/#sec-integerindexedelementset
     inline bool integerIndexedElementSet(ExecutionState& state, double index, const Value& value);
+
+private:
+    TypedArrayType m_typedArrayType;
 };
 
 #define DECLARE_TYPEDARRAY(TYPE, type, siz, nativeType)                                                                                            \
@@ -103,14 +109,10 @@ protected:
         {                                                                                                                                          \
         }                                                                                                                                          \
         explicit TYPE##ArrayObject(ExecutionState& state, Object* proto)                                                                           \
-            : TypedArrayObject(state, proto)                                                                                                       \
+            : TypedArrayObject(state, proto, TypedArrayType::TYPE)                                                                                 \
         {                                                                                                                                          \
         }                                                                                                                                          \
         static TypedArrayObject* allocateTypedArray(ExecutionState& state, Object* newTarget, size_t length = std::numeric_limits<size_t>::max()); \
-        virtual TypedArrayType typedArrayType() override                                                                                           \
-        {                                                                                                                                          \
-            return TypedArrayType::TYPE;                                                                                                           \
-        }                                                                                                                                          \
         virtual String* typedArrayName(ExecutionState& state) override                                                                             \
         {                                                                                                                                          \
             return state.context()->staticStrings().TYPE##Array.string();                                                                          \
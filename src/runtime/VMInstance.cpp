@@ -34,6 +34,12 @@
 #if defined(ENABLE_CODE_CACHE)
 #include "codecache/CodeCache.h"
 #endif
+#if defined(ENABLE_SAMPLING_PROFILER)
+#include "runtime/SamplingProfiler.h"
+#endif
+#if defined(ENABLE_INTERPRETER_STATISTICS)
+#include "interpreter/InterpreterStatistics.h"
+#endif
 
 #if defined(OS_WINDOWS)
 #include <Windows.h>
@@ -127,26 +133,44 @@ static ObjectPropertyNativeGetterSetterData regexpLastIndexGetterSetterData(
 #define ESCARGOT_COMPRESSIBLE_COMPRESS_MIN_SIZE 1024 * 128
 #endif
 
+#if defined(ENABLE_THREADING)
+CompressibleStringCompressor* VMInstance::compressibleStringCompressor()
+{
+    if (!m_compressibleStringCompressor) {
+        m_compressibleStringCompressor = new CompressibleStringCompressor(this);
+    }
+    return m_compressibleStringCompressor;
+}
+#endif
+
 void VMInstance::compressStringsIfNeeds(uint64_t currentTickCount)
 {
-    auto& currentAllocatedCompressibleStrings = compressibleStrings();
-    const size_t& currentAllocatedCompressibleStringsCount = currentAllocatedCompressibleStrings.size();
-    size_t mostBigIndex = SIZE_MAX;
-
-    for (size_t i = 0; i < currentAllocatedCompressibleStringsCount; i++) {
-        if (!currentAllocatedCompressibleStrings[i]->isCompressed()
-            && currentTickCount - currentAllocatedCompressibleStrings[i]->m_lastUsedTickcount > ESCARGOT_COMPRESSIBLE_COMPRESS_USED_BEFORE_INTERVAL
-            && currentAllocatedCompressibleStrings[i]->decomressedBufferSize() > ESCARGOT_COMPRESSIBLE_COMPRESS_MIN_SIZE) {
-            if (mostBigIndex == SIZE_MAX) {
-                mostBigIndex = i;
-            } else if (currentAllocatedCompressibleStrings[i]->decomressedBufferSize() > currentAllocatedCompressibleStrings[mostBigIndex]->decomressedBufferSize()) {
-                mostBigIndex = i;
+#if defined(ENABLE_THREADING)
+    if (m_compressibleStringCompressor) {
+        m_compressibleStringCompressor->applyFinishedTasks();
+    }
+#endif
+
+    // visit idle strings only, from least recently used one
+    CompressibleString* mostBig = nullptr;
+    CompressibleString* str = m_leastRecentlyUsedCompressibleString;
+    while (str && currentTickCount - str->m_lastUsedTickcount > ESCARGOT_COMPRESSIBLE_COMPRESS_USED_BEFORE_INTERVAL) {
+        str->releaseDecompressedWindow();
+        if (!str->isCompressed() && !str->isCompressionPending()
+            && str->decomressedBufferSize() > ESCARGOT_COMPRESSIBLE_COMPRESS_MIN_SIZE) {
+            if (!mostBig || str->decomressedBufferSize() > mostBig->decomressedBufferSize()) {
+                mostBig = str;
             }
         }
+        str = str->m_moreRecentlyUsed;
     }
 
-    if (mostBigIndex != SIZE_MAX) {
-        currentAllocatedCompressibleStrings[mostBigIndex]->compress();
+    if (mostBig) {
+#if defined(ENABLE_THREADING)
+        mostBig->compressInBackground();
+#else
+        mostBig->compress();
+#endif
     }
 }
 #endif
@@ -168,7 +192,13 @@ void* VMInstance::operator new(size_t size)
         DEFINE_GLOBAL_SYMBOLS(DECLARE_GLOBAL_SYMBOLS);
 #undef DECLARE_GLOBAL_SYMBOLS
 
-        GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_globalSymbolRegistry));
+        // we should mark every word of global symbol registry maps
+        for (size_t i = 0; i < sizeof(m_globalSymbolRegistry); i += sizeof(size_t)) {
+            GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_globalSymbolRegistry) + (i / sizeof(size_t)));
+        }
+        for (size_t i = 0; i < sizeof(m_globalSymbolRegistryReverseMap); i += sizeof(size_t)) {
+            GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_globalSymbolRegistryReverseMap) + (i / sizeof(size_t)));
+        }
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_currentSandBox));
 
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_defaultStructureForObject));
@@ -195,6 +225,14 @@ void* VMInstance::operator new(size_t size)
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_intlCollatorAvailableLocales));
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_intlPluralRulesAvailableLocales));
         GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_caseMappingAvailableLocales));
+        GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_intlFormatterCache));
+#endif
+#if defined(ENABLE_SAMPLING_PROFILER)
+        GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_samplingProfiler));
+        GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_allocationSampler));
+#endif
+#if defined(ENABLE_INTERPRETER_STATISTICS)
+        GC_set_bit(desc, GC_WORD_OFFSET(VMInstance, m_interpreterStatistics));
 #endif
 
         descr = GC_make_descriptor(desc, GC_WORD_LEN(VMInstance));
@@ -213,6 +251,11 @@ void vmMarkStartCallback(void* data)
         if (self->m_regexpCache->size() > REGEXP_CACHE_SIZE_MAX || UNLIKELY(self->inIdleMode())) {
             self->m_regexpCache->clear();
         }
+#if defined(ENABLE_ICU) && defined(ENABLE_INTL)
+        if (UNLIKELY(self->inIdleMode())) {
+            self->m_intlFormatterCache.clear();
+        }
+#endif
 
         auto& currentCodeSizeTotal = self->compiledByteCodeSize();
         if (currentCodeSizeTotal > SCRIPT_FUNCTION_OBJECT_BYTECODE_SIZE_MAX || UNLIKELY(self->inIdleMode())) {
@@ -277,6 +320,19 @@ void vmReclaimEndCallback(void* data)
 
 VMInstance::~VMInstance()
 {
+#if defined(ENABLE_SAMPLING_PROFILER)
+    delete m_samplingProfiler;
+    m_samplingProfiler = nullptr;
+    delete m_allocationSampler;
+    m_allocationSampler = nullptr;
+#endif
+#if defined(ENABLE_INTERPRETER_STATISTICS)
+    if (getenv("DUMP_INTERPRETER_STATISTICS")) {
+        m_interpreterStatistics->dump(nullptr, false);
+    }
+    delete m_interpreterStatistics;
+    m_interpreterStatistics = nullptr;
+#endif
     {
         auto& v = compiledByteCodeBlocks();
         for (size_t i = 0; i < v.size(); i++) {
@@ -285,10 +341,18 @@ VMInstance::~VMInstance()
     }
 #if defined(ENABLE_COMPRESSIBLE_STRING)
     {
-        auto& v = compressibleStrings();
-        for (size_t i = 0; i < v.size(); i++) {
-            v[i]->m_isOwnerMayFreed = true;
+#if defined(ENABLE_THREADING)
+        delete m_compressibleStringCompressor;
+        m_compressibleStringCompressor = nullptr;
+#endif
+        CompressibleString* str = m_mostRecentlyUsedCompressibleString;
+        while (str) {
+            CompressibleString* next = str->m_lessRecentlyUsed;
+            str->m_isOwnerMayFreed = true;
+            str->m_moreRecentlyUsed = str->m_lessRecentlyUsed = nullptr;
+            str = next;
         }
+        m_mostRecentlyUsedCompressibleString = m_leastRecentlyUsedCompressibleString = nullptr;
     }
 #endif
 #if defined(ENABLE_RELOADABLE_STRING)
@@ -345,6 +409,11 @@ VMInstance::VMInstance(const char* locale, const char* timezone, const char* bas
 #if defined(ENABLE_COMPRESSIBLE_STRING)
     , m_lastCompressibleStringsTestTime(0)
     , m_compressibleStringsUncomressedBufferSize(0)
+    , m_mostRecentlyUsedCompressibleString(nullptr)
+    , m_leastRecentlyUsedCompressibleString(nullptr)
+#if defined(ENABLE_THREADING)
+    , m_compressibleStringCompressor(nullptr)
+#endif
 #endif
     , m_onVMInstanceDestroy(nullptr)
     , m_onVMInstanceDestroyData(nullptr)
@@ -352,7 +421,16 @@ VMInstance::VMInstance(const char* locale, const char* timezone, const char* bas
     , m_errorCreationCallbackPublic(nullptr)
     , m_promiseHook(nullptr)
     , m_promiseHookPublic(nullptr)
+    , m_stackTraceDepthLimit(STACK_TRACE_DEPTH_LIMIT)
     , m_cachedUTC(nullptr)
+#if defined(ENABLE_SAMPLING_PROFILER)
+    , m_sampleRequested(false)
+    , m_samplingProfiler(nullptr)
+    , m_allocationSampler(nullptr)
+#endif
+#if defined(ENABLE_INTERPRETER_STATISTICS)
+    , m_interpreterStatistics(new InterpreterStatistics())
+#endif
 {
     GC_REGISTER_FINALIZER_NO_ORDER(this, [](void* obj, void*) {
         VMInstance* self = (VMInstance*)obj;
@@ -387,6 +465,7 @@ VMInstance::VMInstance(const char* locale, const char* timezone, const char* bas
 
 #ifdef ENABLE_ICU
     m_timezone = nullptr;
+    clearTimezoneOffsetCache();
     if (timezone) {
         m_timezoneID = timezone;
     } else if (getenv("TZ")) {
@@ -528,7 +607,90 @@ void VMInstance::ensureTimezone()
     }
 
     auto u16 = utf8StringToUTF16String(m_timezoneID.data(), m_timezoneID.size());
+    if (m_timezone) {
+        vzone_close(m_timezone);
+    }
     m_timezone = vzone_openID(u16.data(), u16.size());
+    clearTimezoneOffsetCache();
+}
+
+void VMInstance::clearTimezoneOffsetCache()
+{
+    for (size_t i = 0; i < TIMEZONE_OFFSET_CACHE_SIZE; i++) {
+        // empty range
+        m_timezoneOffsetCache[i].m_start = 1;
+        m_timezoneOffsetCache[i].m_end = 0;
+        m_timezoneOffsetCache[i].m_lastUsed = 0;
+    }
+    m_timezoneOffsetCacheUseCount = 0;
+    m_timezoneRawOffset = 0;
+    m_hasTimezoneRawOffset = false;
+}
+
+bool VMInstance::timezoneOffsetFromICU(int64_t t, int32_t& stdOffset, int32_t& dstOffset)
+{
+    UErrorCode succ = U_ZERO_ERROR;
+    vzone_getOffset3(timezone(), t, true, stdOffset, dstOffset, succ);
+    return !U_FAILURE(succ);
+}
+
+// we assume that there are no two offset transitions within this delta
+#define TIMEZONE_OFFSET_CACHE_DELTA (19LL * 24 * 60 * 60 * 1000)
+
+bool VMInstance::timezoneOffset(int64_t t, int32_t& stdOffset, int32_t& dstOffset)
+{
+    TimezoneOffsetCacheEntry* leastRecentlyUsed = &m_timezoneOffsetCache[0];
+    for (size_t i = 0; i < TIMEZONE_OFFSET_CACHE_SIZE; i++) {
+        TimezoneOffsetCacheEntry& entry = m_timezoneOffsetCache[i];
+        if (entry.m_lastUsed < leastRecentlyUsed->m_lastUsed) {
+            leastRecentlyUsed = &entry;
+        }
+        if (entry.m_start > entry.m_end) {
+            continue;
+        }
+
+        bool hit = entry.m_start <= t && t <= entry.m_end;
+        if (!hit && t > entry.m_end && t - entry.m_end <= TIMEZONE_OFFSET_CACHE_DELTA) {
+            // try to extend range forward
+            int32_t s, d;
+            int64_t newEnd = entry.m_end + TIMEZONE_OFFSET_CACHE_DELTA;
+            if (timezoneOffsetFromICU(newEnd, s, d) && s == entry.m_stdOffset && d == entry.m_dstOffset) {
+                entry.m_end = newEnd;
+                hit = true;
+            } else if (timezoneOffsetFromICU(t, s, d) && s == entry.m_stdOffset && d == entry.m_dstOffset) {
+                entry.m_end = t;
+                hit = true;
+            }
+        } else if (!hit && t < entry.m_start && entry.m_start - t <= TIMEZONE_OFFSET_CACHE_DELTA) {
+            // try to extend range backward
+            int32_t s, d;
+            int64_t newStart = entry.m_start - TIMEZONE_OFFSET_CACHE_DELTA;
+            if (timezoneOffsetFromICU(newStart, s, d) && s == entry.m_stdOffset && d == entry.m_dstOffset) {
+                entry.m_start = newStart;
+                hit = true;
+            } else if (timezoneOffsetFromICU(t, s, d) && s == entry.m_stdOffset && d == entry.m_dstOffset) {
+                entry.m_start = t;
+                hit = true;
+            }
+        }
+
+        if (hit) {
+            entry.m_lastUsed = ++m_timezoneOffsetCacheUseCount;
+            stdOffset = entry.m_stdOffset;
+            dstOffset = entry.m_dstOffset;
+            return true;
+        }
+    }
+
+    if (!timezoneOffsetFromICU(t, stdOffset, dstOffset)) {
+        return false;
+    }
+
+    leastRecentlyUsed->m_start = leastRecentlyUsed->m_end = t;
+    leastRecentlyUsed->m_stdOffset = stdOffset;
+    leastRecentlyUsed->m_dstOffset = dstOffset;
+    leastRecentlyUsed->m_lastUsed = ++m_timezoneOffsetCacheUseCount;
+    return true;
 }
 #endif
 
@@ -545,7 +707,11 @@ DateObject* VMInstance::cachedUTC(ExecutionState& state)
 void VMInstance::clearCachesRelatedWithContext()
 {
     m_regexpCache->clear();
-    globalSymbolRegistry().clear();
+    m_globalSymbolRegistry.clear();
+    m_globalSymbolRegistryReverseMap.clear();
+#if defined(ENABLE_ICU) && defined(ENABLE_INTL)
+    m_intlFormatterCache.clear();
+#endif
 #if defined(ENABLE_CODE_CACHE)
     // CodeCache should be cleared here because CodeCache holds a lock of cache directory
     // this lock should be released immediately (destructor may be called later)
@@ -567,13 +733,20 @@ void VMInstance::enterIdleMode()
 
 #if defined(ENABLE_COMPRESSIBLE_STRING)
     // ESCARGOT_LOG_INFO("compressibleStringsUncomressedBufferSize before %lfKB\n", m_compressibleStringsUncomressedBufferSize/1024.f);
-    auto& currentAllocatedCompressibleStrings = compressibleStrings();
-    const size_t& currentAllocatedCompressibleStringsCount = currentAllocatedCompressibleStrings.size();
-
-    for (size_t i = 0; i < currentAllocatedCompressibleStringsCount; i++) {
-        if (!currentAllocatedCompressibleStrings[i]->isCompressed()) {
-            currentAllocatedCompressibleStrings[i]->compress();
+#if defined(ENABLE_THREADING)
+    if (m_compressibleStringCompressor) {
+        m_compressibleStringCompressor->applyFinishedTasks();
+    }
+#endif
+    CompressibleString* str = m_leastRecentlyUsedCompressibleString;
+    while (str) {
+        if (!str->isCompressed()) {
+            // strings being compressed in background are skipped here
+            str->compress();
+        } else {
+            str->releaseDecompressedWindow();
         }
+        str = str->m_moreRecentlyUsed;
     }
 // ESCARGOT_LOG_INFO("compressibleStringsUncomressedBufferSize after %lfKB\n", m_compressibleStringsUncomressedBufferSize/1024.f);
 #endif
@@ -619,17 +792,101 @@ void VMInstance::enqueueJob(Job* job)
     Global::platform()->markJSJobEnqueued(job->relatedContext());
 }
 
+void VMInstance::enqueuePromiseReactionJob(Context* relatedContext, const PromiseReaction& reaction, const Value& argument)
+{
+    enqueueJob(m_jobQueue->newPromiseReactionJob(relatedContext, reaction, argument));
+}
+
 bool VMInstance::hasPendingJob()
 {
     return m_jobQueue->hasNextJob();
 }
 
+#if defined(ENABLE_SAMPLING_PROFILER)
+bool VMInstance::startSamplingProfiler(size_t intervalInMicroseconds)
+{
+    if (m_samplingProfiler) {
+        return false;
+    }
+    m_samplingProfiler = new SamplingProfiler(&m_sampleRequested, intervalInMicroseconds);
+    return true;
+}
+
+bool VMInstance::stopSamplingProfiler(const char* outputPath)
+{
+    if (!m_samplingProfiler) {
+        return false;
+    }
+    m_samplingProfiler->stop();
+    bool result = !outputPath || m_samplingProfiler->writeCPUProfile(outputPath);
+    delete m_samplingProfiler;
+    m_samplingProfiler = nullptr;
+    return result;
+}
+
+bool VMInstance::startAllocationSampler(size_t sampleInterval)
+{
+    if (m_allocationSampler) {
+        return false;
+    }
+    m_allocationSampler = new AllocationSampler(sampleInterval);
+    return true;
+}
+
+bool VMInstance::stopAllocationSampler(const char* outputPath)
+{
+    if (!m_allocationSampler) {
+        return false;
+    }
+    AllocationSampler* sampler = m_allocationSampler;
+    // stop sampling before resolving positions which can allocate objects
+    m_allocationSampler = nullptr;
+    bool result = !outputPath || sampler->writeAllocationProfile(outputPath);
+    delete sampler;
+    return result;
+}
+#endif
+
 SandBox::SandBoxResult VMInstance::executePendingJob()
 {
-    return m_jobQueue->nextJob()->run();
+    Job* job = m_jobQueue->nextJob();
+    SandBox::SandBoxResult result = job->run();
+    m_jobQueue->didRunJob(job);
+    return result;
 }
 
 #if defined(ENABLE_ICU) && defined(ENABLE_INTL)
+Object* VMInstance::findIntlFormatterCache(IntlFormatterKind kind, const Value& locales)
+{
+    ASSERT(locales.isUndefined() || locales.isString());
+    String* locale = locales.isString() ? locales.asString() : nullptr;
+    for (size_t i = 0; i < m_intlFormatterCache.size(); i++) {
+        IntlFormatterCacheEntry entry = m_intlFormatterCache[i];
+        if (entry.m_kind == kind && (entry.m_locale == locale || (entry.m_locale && locale && entry.m_locale->equals(locale)))) {
+            if (i) {
+                m_intlFormatterCache.erase(i);
+                m_intlFormatterCache.insert(0, entry);
+            }
+            return entry.m_formatter;
+        }
+    }
+    return nullptr;
+}
+
+void VMInstance::addIntlFormatterCache(IntlFormatterKind kind, const Value& locales, Object* formatter)
+{
+    ASSERT(locales.isUndefined() || locales.isString());
+    if (m_intlFormatterCache.size() >= INTL_FORMATTER_CACHE_SIZE_MAX) {
+        m_intlFormatterCache.pop_back();
+    }
+
+    IntlFormatterCacheEntry entry;
+    entry.m_kind = kind;
+    entry.m_locale = locales.isString() ? locales.asString() : nullptr;
+    entry.m_formatter = formatter;
+    m_intlFormatterCache.insert(0, entry);
+}
+
 // some locale have script value on it eg) zh_Hant_HK. so we need to remove it
 static std::string icuLocaleToBCP47LanguageRegionPair(const char* l)
 {
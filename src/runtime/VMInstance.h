@@ -31,10 +31,12 @@ class Context;
 class CodeBlock;
 class JobQueue;
 class Job;
+struct PromiseReaction;
 class Symbol;
 class String;
 #if defined(ENABLE_COMPRESSIBLE_STRING)
 class CompressibleString;
+class CompressibleStringCompressor;
 #endif
 #if defined(ENABLE_RELOADABLE_STRING)
 class ReloadableString;
@@ -42,6 +44,13 @@ class ReloadableString;
 #if defined(ENABLE_CODE_CACHE)
 class CodeCache;
 #endif
+#if defined(ENABLE_SAMPLING_PROFILER)
+class SamplingProfiler;
+class AllocationSampler;
+#endif
+#if defined(ENABLE_INTERPRETER_STATISTICS)
+class InterpreterStatistics;
+#endif
 
 #define DEFINE_GLOBAL_SYMBOLS(F) \
     F(hasInstance)               \
@@ -64,12 +73,10 @@ struct GlobalSymbols {
 #undef DECLARE_GLOBAL_SYMBOLS
 };
 
-struct GlobalSymbolRegistryItem {
-    Optional<String*> key;
-    Symbol* symbol;
-};
-
-typedef Vector<GlobalSymbolRegistryItem, GCUtil::gc_malloc_allocator<GlobalSymbolRegistryItem>> GlobalSymbolRegistryVector;
+// [[Key]] -> [[Symbol]] map of GlobalSymbolRegistry
+typedef std::unordered_map<String*, Symbol*, std::hash<String*>, std::equal_to<String*>, GCUtil::gc_malloc_allocator<std::pair<String* const, Symbol*>>> GlobalSymbolRegistryMap;
+// [[Symbol]] -> [[Key]] map for Symbol.keyFor
+typedef std::unordered_map<Symbol*, String*, std::hash<void*>, std::equal_to<void*>, GCUtil::gc_malloc_allocator<std::pair<Symbol* const, String*>>> GlobalSymbolRegistryReverseMap;
 
 class VMInstance : public gc {
     friend class Context;
@@ -103,11 +110,16 @@ public:
         return m_globalSymbols;
     }
 
-    GlobalSymbolRegistryVector& globalSymbolRegistry()
+    GlobalSymbolRegistryMap& globalSymbolRegistry()
     {
         return m_globalSymbolRegistry;
     }
 
+    GlobalSymbolRegistryReverseMap& globalSymbolRegistryReverseMap()
+    {
+        return m_globalSymbolRegistryReverseMap;
+    }
+
 #if defined(ENABLE_ICU)
     const std::string& locale()
     {
@@ -128,6 +140,19 @@ public:
     }
 
     void ensureTimezone();
+
+    int32_t timezoneRawOffset()
+    {
+        if (UNLIKELY(!m_hasTimezoneRawOffset)) {
+            m_timezoneRawOffset = vzone_getRawOffset(timezone());
+            m_hasTimezoneRawOffset = true;
+        }
+        return m_timezoneRawOffset;
+    }
+
+    // same as vzone_getOffset3 with local time
+    // but offsets are cached by time ranges where they don't change
+    bool timezoneOffset(int64_t t, int32_t& stdOffset, int32_t& dstOffset);
 #endif
     DateObject* cachedUTC(ExecutionState& state);
 
@@ -172,6 +197,8 @@ public:
     }
 
     void enqueueJob(Job* job);
+    // PromiseReactionJob record is reused from JobQueue if possible
+    void enqueuePromiseReactionJob(Context* relatedContext, const PromiseReaction& reaction, const Value& argument);
     bool hasPendingJob();
     SandBox::SandBoxResult executePendingJob();
 
@@ -186,11 +213,21 @@ public:
     }
 
 #if defined(ENABLE_COMPRESSIBLE_STRING)
-    std::vector<CompressibleString*>& compressibleStrings()
+    // compressible strings are linked from most recently used one
+    CompressibleString*& mostRecentlyUsedCompressibleString()
     {
-        return m_compressibleStrings;
+        return m_mostRecentlyUsedCompressibleString;
     }
 
+    CompressibleString*& leastRecentlyUsedCompressibleString()
+    {
+        return m_leastRecentlyUsedCompressibleString;
+    }
+
+#if defined(ENABLE_THREADING)
+    CompressibleStringCompressor* compressibleStringCompressor();
+#endif
+
     size_t& compressibleStringsUncomressedBufferSize()
     {
         return m_compressibleStringsUncomressedBufferSize;
@@ -219,6 +256,30 @@ public:
         return m_regexpOptionStringCache;
     }
 
+#if defined(ENABLE_ICU) && defined(ENABLE_INTL)
+    // formatters created by locale-sensitive builtins (e.g. String.prototype.localeCompare)
+    enum IntlFormatterKind : uint8_t {
+        IntlCollatorKind,
+        IntlNumberFormatKind,
+        IntlDateTimeFormatKind,
+        IntlDateFormatKind,
+        IntlTimeFormatKind,
+    };
+
+    static bool canUseIntlFormatterCache(const Value& locales, const Value& options)
+    {
+        // reading options object is observable, so only default options are cached
+        return options.isUndefined() && (locales.isUndefined() || locales.isString());
+    }
+
+    Object* findIntlFormatterCache(IntlFormatterKind kind, const Value& locales);
+    void addIntlFormatterCache(IntlFormatterKind kind, const Value& locales, Object* formatter);
+    size_t intlFormatterCacheSize() const
+    {
+        return m_intlFormatterCache.size();
+    }
+#endif
+
     void setOnDestroyCallback(void (*onVMInstanceDestroy)(VMInstance* instance, void* data), void* data)
     {
         m_onVMInstanceDestroy = onVMInstanceDestroy;
@@ -277,6 +338,17 @@ public:
         }
     }
 
+    // max count of frames recorded when exception is thrown
+    size_t stackTraceDepthLimit() const
+    {
+        return m_stackTraceDepthLimit;
+    }
+
+    void setStackTraceDepthLimit(size_t limit)
+    {
+        m_stackTraceDepthLimit = limit;
+    }
+
 #if defined(ENABLE_ICU) && defined(ENABLE_INTL)
     const Vector<String*, GCUtil::gc_malloc_allocator<String*>>& intlCollatorAvailableLocales();
     const Vector<String*, GCUtil::gc_malloc_allocator<String*>>& intlDateTimeFormatAvailableLocales();
@@ -296,11 +368,43 @@ public:
     }
 #endif
 
+#if defined(ENABLE_SAMPLING_PROFILER)
+    // set by timer thread of SamplingProfiler, checked by interpreter
+    bool isSampleRequested()
+    {
+        return m_sampleRequested.load(std::memory_order_relaxed);
+    }
+
+    SamplingProfiler* samplingProfiler()
+    {
+        return m_samplingProfiler;
+    }
+
+    bool startSamplingProfiler(size_t intervalInMicroseconds);
+    bool stopSamplingProfiler(const char* outputPath);
+
+    AllocationSampler* allocationSampler()
+    {
+        return m_allocationSampler;
+    }
+
+    bool startAllocationSampler(size_t sampleInterval);
+    bool stopAllocationSampler(const char* outputPath);
+#endif
+
+#if defined(ENABLE_INTERPRETER_STATISTICS)
+    InterpreterStatistics* interpreterStatistics()
+    {
+        return m_interpreterStatistics;
+    }
+#endif
+
 private:
     StaticStrings m_staticStrings;
     AtomicStringMap m_atomicStringMap;
     GlobalSymbols m_globalSymbols;
-    GlobalSymbolRegistryVector m_globalSymbolRegistry;
+    GlobalSymbolRegistryMap m_globalSymbolRegistry;
+    GlobalSymbolRegistryReverseMap m_globalSymbolRegistryReverseMap;
     SandBox* m_currentSandBox;
 
     bool m_isFinalized;
@@ -332,7 +436,11 @@ private:
 #if defined(ENABLE_COMPRESSIBLE_STRING)
     uint64_t m_lastCompressibleStringsTestTime;
     size_t m_compressibleStringsUncomressedBufferSize;
-    std::vector<CompressibleString*> m_compressibleStrings;
+    CompressibleString* m_mostRecentlyUsedCompressibleString;
+    CompressibleString* m_leastRecentlyUsedCompressibleString;
+#if defined(ENABLE_THREADING)
+    CompressibleStringCompressor* m_compressibleStringCompressor;
+#endif
 
     NEVER_INLINE void compressStringsIfNeeds(uint64_t currentTickCount = fastTickCount());
 #endif
@@ -352,6 +460,8 @@ private:
     PromiseHook m_promiseHook;
     void* m_promiseHookPublic;
 
+    size_t m_stackTraceDepthLimit;
+
     ToStringRecursionPreventer m_toStringRecursionPreventer;
 
     void* m_stackStartAddress;
@@ -365,12 +475,27 @@ private:
     std::string m_locale;
     VZone* m_timezone;
     std::string m_timezoneID;
+
+    void clearTimezoneOffsetCache();
+    bool timezoneOffsetFromICU(int64_t t, int32_t& stdOffset, int32_t& dstOffset);
+
+    // timezone offset is constant in [m_start, m_end]
+    struct TimezoneOffsetCacheEntry {
+        int64_t m_start;
+        int64_t m_end;
+        int32_t m_stdOffset;
+        int32_t m_dstOffset;
+        size_t m_lastUsed;
+    };
+    TimezoneOffsetCacheEntry m_timezoneOffsetCache[TIMEZONE_OFFSET_CACHE_SIZE];
+    size_t m_timezoneOffsetCacheUseCount;
+    int32_t m_timezoneRawOffset;
+    bool m_hasTimezoneRawOffset;
 #endif
     DateObject* m_cachedUTC;
 
     // promise job queue
     JobQueue* m_jobQueue;
-
 #if defined(ENABLE_ICU) && defined(ENABLE_INTL)
     void ensureIntlSupportedLocales();
     // we expect uloc_, udat_, unum_ returns same supported locales
@@ -378,11 +503,29 @@ private:
     Vector<String*, GCUtil::gc_malloc_allocator<String*>> m_intlCollatorAvailableLocales;
     Vector<String*, GCUtil::gc_malloc_allocator<String*>> m_intlPluralRulesAvailableLocales;
     Vector<String*, GCUtil::gc_malloc_allocator<String*>> m_caseMappingAvailableLocales;
+
+    struct IntlFormatterCacheEntry {
+        IntlFormatterKind m_kind;
+        String* m_locale; // nullptr for default locale
+        Object* m_formatter;
+    };
+    // ordered from most recently used one
+    Vector<IntlFormatterCacheEntry, GCUtil::gc_malloc_allocator<IntlFormatterCacheEntry>> m_intlFormatterCache;
 #endif
 
 #if defined(ENABLE_CODE_CACHE)
     CodeCache* m_codeCache;
 #endif
+
+#if defined(ENABLE_SAMPLING_PROFILER)
+    std::atomic<bool> m_sampleRequested;
+    SamplingProfiler* m_samplingProfiler;
+    AllocationSampler* m_allocationSampler;
+#endif
+
+#if defined(ENABLE_INTERPRETER_STATISTICS)
+    InterpreterStatistics* m_interpreterStatistics;
+#endif
 };
 } // namespace Escargot
 
@@ -36,9 +36,10 @@
 
 namespace Escargot {
 
-ExportedFunctionObject::ExportedFunctionObject(ExecutionState& state, NativeFunctionInfo info, wasm_func_t* func)
+ExportedFunctionObject::ExportedFunctionObject(ExecutionState& state, NativeFunctionInfo info, wasm_func_t* func, const SimpleSignature& signature)
     : NativeFunctionObject(state, info)
     , m_function(func)
+    , m_simpleSignature(signature)
 {
     ASSERT(!!m_function);
 
@@ -62,6 +63,76 @@ void* ExportedFunctionObject::operator new(size_t size)
     return GC_MALLOC_EXPLICITLY_TYPED(size, descr);
 }
 
+void ExportedFunctionObject::readSimpleSignature(wasm_func_t* func, SimpleSignature& signature)
+{
+    own wasm_functype_t* functype = wasm_func_type(func);
+    const wasm_valtype_vec_t* parameters = wasm_functype_params(functype);
+    const wasm_valtype_vec_t* results = wasm_functype_results(functype);
+
+    bool isSimple = parameters->size <= ESCARGOT_WASM_SIMPLE_SIGNATURE_PARAMETER_COUNT_MAX && results->size <= 1;
+    for (size_t i = 0; isSimple && i < parameters->size; i++) {
+        isSimple = wasm_valkind_is_num(wasm_valtype_kind(parameters->data[i]));
+    }
+    if (isSimple && results->size) {
+        isSimple = wasm_valkind_is_num(wasm_valtype_kind(results->data[0]));
+    }
+
+    if (isSimple) {
+        signature.m_isSimple = true;
+        signature.m_parameterCount = parameters->size;
+        for (size_t i = 0; i < parameters->size; i++) {
+            signature.m_parameterTypes[i] = wasm_valtype_kind(parameters->data[i]);
+        }
+        signature.m_resultCount = results->size;
+        if (results->size) {
+            signature.m_resultType = wasm_valtype_kind(results->data[0]);
+        }
+    }
+
+    wasm_functype_delete(functype);
+}
+
+static void throwWASMFuncCallError(ExecutionState& state, own wasm_trap_t* trap)
+{
+    own wasm_name_t message;
+    wasm_trap_message(trap, &message);
+    ESCARGOT_LOG_ERROR("[WASM Message] %s\n", message.data);
+    wasm_name_delete(&message);
+    wasm_trap_delete(trap);
+    ErrorObject::throwBuiltinError(state, ErrorObject::WASMRuntimeError, ErrorObject::Messages::WASM_FuncCallError);
+}
+
+// trampoline for functions of simple signature
+// signature is cached in the function object and arguments are kept in a fixed size buffer
+static Value callExportedFunctionWithSimpleSignature(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
+{
+    ExportedFunctionObject* callee = state.resolveCallee()->asExportedFunctionObject();
+    const ExportedFunctionObject::SimpleSignature& signature = callee->simpleSignature();
+
+    wasm_val_t args[ESCARGOT_WASM_SIMPLE_SIGNATURE_PARAMETER_COUNT_MAX];
+    for (size_t i = 0; i < signature.m_parameterCount; i++) {
+        Value arg = (argc > i) ? argv[i] : Value();
+        args[i] = WASMValueConverter::wasmToWebAssemblyValue(state, arg, signature.m_parameterTypes[i]);
+    }
+
+    wasm_val_t ret[1];
+    own wasm_trap_t* trap = wasm_func_call(callee->function(), args, ret);
+    // wabt allocates a Thread object for each function call
+    // collect it with other garbages in the store instead of collecting the store for each call
+    WASMOperations::collectHeapIfNeeded();
+
+    if (trap) {
+        throwWASMFuncCallError(state, trap);
+        return Value();
+    }
+
+    if (signature.m_resultCount == 0) {
+        return Value();
+    }
+    ASSERT(ret[0].kind == signature.m_resultType);
+    return WASMValueConverter::wasmToJSValue(state, ret[0]);
+}
+
 static Value callExportedFunction(ExecutionState& state, Value thisValue, size_t argc, Value* argv, Optional<Object*> newTarget)
 {
     ExportedFunctionObject* callee = state.resolveCallee()->asExportedFunctionObject();
@@ -95,19 +166,12 @@ static Value callExportedFunction(ExecutionState& state, Value thisValue, size_t
 
     // Let (store, ret) be the result of func_invoke(store, funcaddr, args).
     own wasm_trap_t* trap = wasm_func_call(funcaddr, args.data, ret.data);
-    // FIXME wabt allocates a Thread object for each function call
-    // Thread object is never explicitly reclaimed
-    // invoke collectHeap right after wasm_func_call
-    WASMOperations::collectHeap();
+    // Thread object allocated for this call is reclaimed by amortized store collection
+    WASMOperations::collectHeapIfNeeded();
 
     // If ret is error, throw an exception. This exception should be a WebAssembly RuntimeError exception, unless otherwise indicated by the WebAssembly error mapping.
     if (trap) {
-        own wasm_name_t message;
-        wasm_trap_message(trap, &message);
-        ESCARGOT_LOG_ERROR("[WASM Message] %s\n", message.data);
-        wasm_name_delete(&message);
-        wasm_trap_delete(trap);
-        ErrorObject::throwBuiltinError(state, ErrorObject::WASMRuntimeError, ErrorObject::Messages::WASM_FuncCallError);
+        throwWASMFuncCallError(state, trap);
         return Value();
     }
 
@@ -171,7 +235,11 @@ ExportedFunctionObject* ExportedFunctionObject::createExportedFunction(Execution
     // Let realm be the current Realm.
     // Let function be CreateBuiltinFunction(realm, steps, %FunctionPrototype%, ? [[FunctionAddress]] ?).
     // Set function.[[FunctionAddress]] to funcaddr.
-    ExportedFunctionObject* function = new ExportedFunctionObject(state, NativeFunctionInfo(name, callExportedFunction, arity, NativeFunctionInfo::Strict), funcaddr);
+    // functions of simple signature are called through the specialized trampoline
+    ExportedFunctionObject::SimpleSignature signature;
+    readSimpleSignature(funcaddr, signature);
+    NativeFunctionPointer steps = signature.m_isSimple ? callExportedFunctionWithSimpleSignature : callExportedFunction;
+    ExportedFunctionObject* function = new ExportedFunctionObject(state, NativeFunctionInfo(name, steps, arity, NativeFunctionInfo::Strict), funcaddr, signature);
 
     // Set map[funcaddr] to function.
     map.pushBack(std::make_pair(funcref, function));
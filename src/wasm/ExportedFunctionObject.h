@@ -24,11 +24,34 @@
 
 struct wasm_func_t;
 
+// functions which have numeric parameters up to this count and at most one numeric result
+// are called through the trampoline without querying functype for each call
+#ifndef ESCARGOT_WASM_SIMPLE_SIGNATURE_PARAMETER_COUNT_MAX
+#define ESCARGOT_WASM_SIMPLE_SIGNATURE_PARAMETER_COUNT_MAX 4
+#endif
+
 namespace Escargot {
 
 class ExportedFunctionObject : public NativeFunctionObject {
 public:
-    explicit ExportedFunctionObject(ExecutionState& state, NativeFunctionInfo info, wasm_func_t* func);
+    struct SimpleSignature {
+        SimpleSignature()
+            : m_isSimple(false)
+            , m_parameterCount(0)
+            , m_resultCount(0)
+            , m_resultType(0)
+        {
+        }
+
+        bool m_isSimple;
+        uint8_t m_parameterCount;
+        uint8_t m_resultCount;
+        // wasm_valkind_t
+        uint8_t m_parameterTypes[ESCARGOT_WASM_SIMPLE_SIGNATURE_PARAMETER_COUNT_MAX];
+        uint8_t m_resultType;
+    };
+
+    explicit ExportedFunctionObject(ExecutionState& state, NativeFunctionInfo info, wasm_func_t* func, const SimpleSignature& signature);
 
     virtual bool isExportedFunctionObject() const override
     {
@@ -48,8 +71,17 @@ public:
         return m_function;
     }
 
+    const SimpleSignature& simpleSignature() const
+    {
+        ASSERT(m_simpleSignature.m_isSimple);
+        return m_simpleSignature;
+    }
+
 private:
+    static void readSimpleSignature(wasm_func_t* func, SimpleSignature& signature);
+
     wasm_func_t* m_function;
+    SimpleSignature m_simpleSignature;
 };
 } // namespace Escargot
 #endif // __EscargotExportedFunctionObject__
@@ -38,6 +38,12 @@
 // object marked with 'own' should be deleted in the current context
 #define own
 
+// wabt reserves value stack and call stack of a Thread object up front for each call
+// so even a few uncollected calls hold a lot of memory inside the store
+#ifndef ESCARGOT_WASM_GC_CALL_COUNT_LIMIT
+#define ESCARGOT_WASM_GC_CALL_COUNT_LIMIT (16)
+#endif
+
 namespace Escargot {
 
 static own wasm_trap_t* callbackHostFunction(void* env, const wasm_val_t args[], wasm_val_t results[])
@@ -565,6 +571,16 @@ void WASMOperations::collectHeap()
     wasm_store_gc(ThreadLocal::wasmStore());
 }
 
+void WASMOperations::collectHeapIfNeeded()
+{
+    // wabt does not report size of allocation inside store
+    // so store is collected by count of calls
+    size_t& callCountSinceGC = ThreadLocal::wasmCallCountSinceGC();
+    if (UNLIKELY(++callCountSinceGC >= ESCARGOT_WASM_GC_CALL_COUNT_LIMIT)) {
+        ThreadLocal::wasmGC(fastTickCount());
+    }
+}
+
 } // namespace Escargot
 
 #endif // ENABLE_WASM
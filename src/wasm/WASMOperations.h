@@ -40,6 +40,8 @@ public:
     static Object* instantiatePromiseOfModuleWithImportObject(ExecutionState& state, PromiseObject* promiseOfModule, Value importObj);
 
     static void collectHeap();
+    // collect store when count of calls since last collection reaches the limit
+    static void collectHeapIfNeeded();
 };
 
 } // namespace Escargot
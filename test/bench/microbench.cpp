@@ -0,0 +1,427 @@
+/*
+ * Copyright (c) 2021-present Samsung Electronics Co., Ltd
+ *
+ *  This library is free software; you can redistribute it and/or
+ *  modify it under the terms of the GNU Lesser General Public
+ *  License as published by the Free Software Foundation; either
+ *  version 2.1 of the License, or (at your option) any later version.
+ *
+ *  This library is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ *  Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public
+ *  License along with this library; if not, write to the Free Software
+ *  Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301
+ *  USA
+ */
+
+#include "api/EscargotPublic.h"
+
+using namespace Escargot;
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+// escargot-bench runs each microbenchmark `samples` times after `warmup` runs
+// and reports min/median/mean/stddev of one sample in nanoseconds as JSON
+// each JS benchmark defines `function run()` which executes its hot path `iterations` times
+
+struct BenchmarkResult {
+    std::string name;
+    size_t iterations;
+    std::vector<double> samples;
+};
+
+struct BenchmarkOptions {
+    size_t warmup;
+    size_t samples;
+    std::string filter;
+    std::string output;
+    std::string cacheDir;
+
+    BenchmarkOptions()
+        : warmup(3)
+        , samples(15)
+        , cacheDir("/tmp/escargot-bench-cache")
+    {
+    }
+};
+
+struct ScriptBenchmark {
+    const char* name;
+    size_t iterations;
+    const char* source;
+};
+
+// keep sources small enough so that each sample takes a few milliseconds
+static const ScriptBenchmark s_scriptBenchmarks[] = {
+    { "property.get.monomorphic", 1000000,
+      "var o = { a: 1, b: 2, c: 3 };"
+      "function run(n) { var s = 0; for (var i = 0; i < n; i++) { s += o.b; } return s; }" },
+    { "property.get.polymorphic", 1000000,
+      "var os = [{ a: 1, b: 2 }, { b: 2, a: 1 }, { x: 0, a: 1, b: 2 }, { y: 0, b: 2 }];"
+      "function run(n) { var s = 0; for (var i = 0; i < n; i++) { s += os[i & 3].b; } return s; }" },
+    { "property.set", 1000000,
+      "var o = { a: 1, b: 2, c: 3 };"
+      "function run(n) { for (var i = 0; i < n; i++) { o.c = i; } return o.c; }" },
+    { "property.add", 100000,
+      "function run(n) { var o; for (var i = 0; i < n; i++) { o = {}; o.a = i; o.b = i; o.c = i; } return o; }" },
+    { "call.function", 1000000,
+      "function f(a, b) { return a + b; }"
+      "function run(n) { var s = 0; for (var i = 0; i < n; i++) { s = f(s, 1); } return s; }" },
+    { "call.method", 1000000,
+      "var o = { f: function(a) { return a + 1; } };"
+      "function run(n) { var s = 0; for (var i = 0; i < n; i++) { s = o.f(s); } return s; }" },
+    { "call.closure", 1000000,
+      "function make() { var c = 0; return function() { return ++c; }; }"
+      "var g = make();"
+      "function run(n) { var s = 0; for (var i = 0; i < n; i++) { s = g(); } return s; }" },
+    { "call.native", 1000000,
+      "function run(n) { var s = 0; for (var i = 0; i < n; i++) { s = Math.max(s, i); } return s; }" },
+    { "string.concat", 100000,
+      "function run(n) { var s = ''; for (var i = 0; i < n; i++) { s += 'ab'; } return s.length; }" },
+    { "string.indexOf", 100000,
+      "var str = 'abcdefghij'.repeat(100) + 'needle';"
+      "function run(n) { var s = 0; for (var i = 0; i < n; i++) { s += str.indexOf('needle'); } return s; }" },
+    { "map.set.get", 100000,
+      "function run(n) { var m = new Map(); for (var i = 0; i < n; i++) { m.set(i, i); } var s = 0; for (var i = 0; i < n; i++) { s += m.get(i); } return s; }" },
+    { "set.add.has", 100000,
+      "function run(n) { var m = new Set(); for (var i = 0; i < n; i++) { m.add('k' + (i & 1023)); } var s = 0; for (var i = 0; i < n; i++) { if (m.has('k' + (i & 1023))) s++; } return s; }" },
+    { "json.parse", 1000,
+      "var text = JSON.stringify({ a: [1, 2, 3, 4, 5], b: 'string value', c: { d: true, e: null, f: 1.5 }, g: new Array(50).fill({ h: 1 }) });"
+      "function run(n) { var r; for (var i = 0; i < n; i++) { r = JSON.parse(text); } return r; }" },
+    { "json.stringify", 1000,
+      "var obj = { a: [1, 2, 3, 4, 5], b: 'string value', c: { d: true, e: null, f: 1.5 }, g: new Array(50).fill({ h: 1 }) };"
+      "function run(n) { var r; for (var i = 0; i < n; i++) { r = JSON.stringify(obj); } return r; }" },
+    { "json.stringify.records", 100,
+      "var records = []; for (var i = 0; i < 200; i++) { records.push({ id: i, name: 'record' + i, score: i * 0.25, active: (i & 1) == 0, tags: ['alpha', 'beta', 'gamma'], address: { street: 'Main Street ' + i, city: 'Seoul', zip: null } }); }"
+      "function run(n) { var r; for (var i = 0; i < n; i++) { r = JSON.stringify(records); } return r; }" },
+    { "json.stringify.indent", 100,
+      "var records = []; for (var i = 0; i < 200; i++) { records.push({ id: i, name: 'record' + i, tags: ['alpha', 'beta'], address: { city: 'Seoul', zip: null } }); }"
+      "function run(n) { var r; for (var i = 0; i < n; i++) { r = JSON.stringify(records, null, 2); } return r; }" },
+    { "json.stringify.replacer", 100,
+      "var records = []; for (var i = 0; i < 200; i++) { records.push({ id: i, name: 'record' + i, tags: ['alpha', 'beta'], address: { city: 'Seoul', zip: null } }); }"
+      "function run(n) { var r; for (var i = 0; i < n; i++) { r = JSON.stringify(records, function(k, v) { return v; }); } return r; }" },
+    { "json.stringify.numbers", 100,
+      "var numbers = []; for (var i = 0; i < 2000; i++) numbers.push(i * 3);"
+      "function run(n) { var r; for (var i = 0; i < n; i++) { r = JSON.stringify(numbers); } return r; }" },
+    { "json.stringify.escaped", 100,
+      "var lines = []; for (var i = 0; i < 200; i++) lines.push('line ' + i + '\\n\\t\\\"quoted\\\" \\\\ text which is long enough to be scanned by words');"
+      "function run(n) { var r; for (var i = 0; i < n; i++) { r = JSON.stringify(lines); } return r; }" },
+    { "json.stringify.deep", 100,
+      "var deep = { leaf: true }; for (var i = 0; i < 500; i++) deep = { child: deep, level: i };"
+      "function run(n) { var r; for (var i = 0; i < n; i++) { r = JSON.stringify(deep); } return r; }" },
+    { "regexp.exec", 100000,
+      "var re = /([a-z]+)@([a-z]+)\\.com/;"
+      "function run(n) { var r; for (var i = 0; i < n; i++) { r = re.exec('contact: someone@example.com'); } return r; }" },
+    { "regexp.replace", 10000,
+      "var str = 'The quick brown fox jumps over the lazy dog. '.repeat(10);"
+      "function run(n) { var r; for (var i = 0; i < n; i++) { r = str.replace(/o/g, '0'); } return r; }" },
+    { "array.push.pop", 1000000,
+      "var arr = [];"
+      "function run(n) { for (var i = 0; i < n; i++) { arr.push(i); } for (var i = 0; i < n; i++) { arr.pop(); } return arr.length; }" },
+    { "array.builtins", 1000,
+      "var arr = []; for (var i = 0; i < 1000; i++) arr.push(i);"
+      "function run(n) { var s = 0; for (var i = 0; i < n; i++) { s += arr.map(function(x) { return x * 2; }).filter(function(x) { return x & 4; }).reduce(function(a, b) { return a + b; }, 0); } return s; }" },
+    { "array.sort", 100,
+      "var arr = []; for (var i = 0; i < 1000; i++) arr.push((i * 7919) % 1000);"
+      "function run(n) { var r; for (var i = 0; i < n; i++) { r = arr.slice().sort(function(a, b) { return a - b; }); } return r; }" },
+    { "array.indexOf", 1000,
+      "var arr = []; for (var i = 0; i < 1000; i++) arr.push(i);"
+      "function run(n) { var s = 0; for (var i = 0; i < n; i++) { s += arr.indexOf(999) + arr.lastIndexOf(0) + arr.includes(-1); } return s; }" },
+    { "array.join", 1000,
+      "var arr = []; for (var i = 0; i < 1000; i++) arr.push(i);"
+      "function run(n) { var r; for (var i = 0; i < n; i++) { r = arr.join(','); } return r; }" },
+    { "array.slice.splice", 1000,
+      "var arr = []; for (var i = 0; i < 1000; i++) arr.push({ v: i });"
+      "function run(n) { var r; for (var i = 0; i < n; i++) { r = arr.slice(0); r.splice(500, 10, 1, 2, 3); } return r; }" },
+    { "array.concat", 1000,
+      "var ints = [], doubles = []; for (var i = 0; i < 1000; i++) { ints.push(i); doubles.push(i + 0.5); }"
+      "function run(n) { var r; for (var i = 0; i < n; i++) { r = ints.concat(doubles); } return r; }" },
+    { "array.fill.reverse", 1000,
+      "function run(n) { var r; for (var i = 0; i < n; i++) { r = new Array(1000).fill(i).reverse(); } return r; }" },
+    { "array.iteration", 1000,
+      "var arr = []; for (var i = 0; i < 1000; i++) arr.push(i);"
+      "function run(n) { var s = 0; for (var i = 0; i < n; i++) { arr.forEach(function(v) { s += v; }); s += arr.every(function(v) { return v >= 0; }) + arr.some(function(v) { return v < 0; }); } return s; }" },
+    { "array.push.spread", 1000,
+      "var part = []; for (var i = 0; i < 100; i++) part.push(i);"
+      "function run(n) { var r; for (var i = 0; i < n; i++) { r = []; r.push(...part); r.push(...part); } return r; }" },
+    { "bigint.counter", 100000,
+      "function run(n) { var c = 0n; for (var i = 0; i < n; i++) { c++; } return c; }" },
+    { "bigint.add.sub", 100000,
+      "function run(n) { var a = 1n, b = 3n, c = 2n; for (var i = 0; i < n; i++) { a = a + b; a = a - c; } return a; }" },
+    { "bigint.mul.div.mod", 100000,
+      "function run(n) { var a = 123456789n, r = 0n; for (var i = 0; i < n; i++) { r += (a * 7n) / 3n % 1000n; } return r; }" },
+    { "bigint.compare", 100000,
+      "function run(n) { var a = 0n, s = 0; for (var i = 0; i < n; i++) { if (a < 1000n) s++; a += 1n; } return s; }" },
+    { "bigint.bitwise", 100000,
+      "function run(n) { var a = 0x12345678n, r = 0n; for (var i = 0; i < n; i++) { r ^= ((a << 3n) >> 2n) & 0xffffn | 1n; } return r; }" },
+    { "bigint.typedarray", 100000,
+      "var arr = new BigInt64Array(1024); for (var i = 0; i < arr.length; i++) arr[i] = BigInt(i) * 12345n;"
+      "function run(n) { var r = 0n; for (var i = 0; i < n; i++) { var idx = i & 1023; arr[idx] = arr[idx] + 1n; r += arr[idx]; } return r; }" },
+    { "bigint.overflow", 10000,
+      "function run(n) { var a = 1n; for (var i = 0; i < n; i++) { a = (a * 0x7fffffffffffn) % 0xffffffffffffffffffffn; } return a; }" },
+    { "gc.allocation", 1000000,
+      "function run(n) { var o; for (var i = 0; i < n; i++) { o = { a: i, b: [i] }; } return o; }" },
+};
+
+static double nowInNanoseconds()
+{
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+class BenchmarkPlatform : public PlatformRef {
+public:
+    virtual void markJSJobEnqueued(ContextRef* relatedContext) override
+    {
+        // ignore. we always check pending job after running each sample
+    }
+
+    virtual LoadModuleResult onLoadModule(ContextRef* relatedContext, ScriptRef* whereRequestFrom, StringRef* moduleSrc) override
+    {
+        return LoadModuleResult(ErrorObjectRef::Code::None, StringRef::createFromASCII("module is not supported in escargot-bench"));
+    }
+
+    virtual void didLoadModule(ContextRef* relatedContext, OptionalRef<ScriptRef> whereRequestFrom, ScriptRef* loadedModule) override
+    {
+    }
+};
+
+static bool evalScript(ContextRef* context, StringRef* source, StringRef* srcName)
+{
+    auto scriptInitializeResult = context->scriptParser()->initializeScript(source, srcName, false);
+    if (!scriptInitializeResult.script) {
+        fprintf(stderr, "Script parsing error: %s\n", scriptInitializeResult.parseErrorMessage->toStdUTF8String().data());
+        return false;
+    }
+
+    auto evalResult = Evaluator::execute(context, [](ExecutionStateRef* state, ScriptRef* script) -> ValueRef* {
+        return script->execute(state);
+    },
+                                         scriptInitializeResult.script.get());
+
+    if (!evalResult.isSuccessful()) {
+        fprintf(stderr, "Uncaught %s\n", evalResult.resultOrErrorToString(context)->toStdUTF8String().data());
+        return false;
+    }
+
+    while (context->vmInstance()->hasPendingJob()) {
+        context->vmInstance()->executePendingJob();
+    }
+    return true;
+}
+
+static bool runSample(ContextRef* context, size_t iterations)
+{
+    auto result = Evaluator::execute(context, [](ExecutionStateRef* state, size_t iterations) -> ValueRef* {
+        ValueRef* run = state->context()->globalObject()->get(state, StringRef::createFromASCII("run"));
+        ValueRef* argv[1] = { ValueRef::create(iterations) };
+        return run->call(state, ValueRef::createUndefined(), 1, argv);
+    },
+                                     iterations);
+    if (!result.isSuccessful()) {
+        fprintf(stderr, "Uncaught %s\n", result.resultOrErrorToString(context)->toStdUTF8String().data());
+        return false;
+    }
+    return true;
+}
+
+static bool runScriptBenchmark(VMInstanceRef* instance, const ScriptBenchmark& bench, const BenchmarkOptions& options, BenchmarkResult& result)
+{
+    // each benchmark gets fresh context not to be affected by previous benchmarks
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance);
+    if (!evalScript(context.get(), StringRef::createFromUTF8(bench.source, strlen(bench.source)), StringRef::createFromASCII("bench.js"))) {
+        return false;
+    }
+
+    Memory::gc();
+
+    for (size_t i = 0; i < options.warmup; i++) {
+        if (!runSample(context.get(), bench.iterations)) {
+            return false;
+        }
+    }
+
+    result.name = bench.name;
+    result.iterations = bench.iterations;
+    for (size_t i = 0; i < options.samples; i++) {
+        double start = nowInNanoseconds();
+        if (!runSample(context.get(), bench.iterations)) {
+            return false;
+        }
+        result.samples.push_back(nowInNanoseconds() - start);
+    }
+
+    context.release();
+    Memory::gc();
+    return true;
+}
+
+static bool runCodeCacheBenchmark(const BenchmarkOptions& options, BenchmarkResult& result)
+{
+    // source should be larger than CODE_CACHE_MIN_SOURCE_LENGTH to be cached
+    std::string source;
+    for (size_t i = 0; i < 200; i++) {
+        source += "function f" + std::to_string(i) + "(a, b) { var c = a + b; if (c > 10) { return [a, b, c].map(function(x) { return x * 2; }); } return { a: a, b: b }; }\n";
+    }
+
+    PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create(nullptr, nullptr, options.cacheDir.data());
+    PersistentRefHolder<ContextRef> context = ContextRef::create(instance.get());
+
+    StringRef* srcName = StringRef::createFromASCII("codecache-bench.js");
+    auto loadScript = [&]() -> bool {
+        auto initResult = context->scriptParser()->initializeScript(StringRef::createFromUTF8(source.data(), source.length()), srcName, false);
+        return initResult.isSuccessful();
+    };
+
+    // first run stores the cache
+    for (size_t i = 0; i < options.warmup + 1; i++) {
+        if (!loadScript()) {
+            return false;
+        }
+    }
+
+    result.name = "codecache.load";
+    result.iterations = 1;
+    for (size_t i = 0; i < options.samples; i++) {
+        double start = nowInNanoseconds();
+        if (!loadScript()) {
+            return false;
+        }
+        result.samples.push_back(nowInNanoseconds() - start);
+    }
+
+    context.release();
+    instance.release();
+    Memory::gc();
+    return true;
+}
+
+static void writeResults(FILE* fp, const std::vector<BenchmarkResult>& results, const BenchmarkOptions& options)
+{
+    fprintf(fp, "{\n  \"warmup\": %zu,\n  \"samples\": %zu,\n  \"unit\": \"ns\",\n  \"benchmarks\": [", options.warmup, options.samples);
+    for (size_t i = 0; i < results.size(); i++) {
+        std::vector<double> sorted = results[i].samples;
+        std::sort(sorted.begin(), sorted.end());
+
+        double sum = 0;
+        for (double s : sorted) {
+            sum += s;
+        }
+        double mean = sum / sorted.size();
+        double variance = 0;
+        for (double s : sorted) {
+            variance += (s - mean) * (s - mean);
+        }
+        double stddev = sorted.size() > 1 ? std::sqrt(variance / (sorted.size() - 1)) : 0;
+        double median = sorted.size() % 2 ? sorted[sorted.size() / 2] : (sorted[sorted.size() / 2 - 1] + sorted[sorted.size() / 2]) / 2;
+
+        fprintf(fp, "%s\n    { \"name\": \"%s\", \"iterations\": %zu, \"min\": %.0f, \"median\": %.0f, \"mean\": %.0f, \"stddev\": %.0f, \"max\": %.0f, \"perIteration\": %.3f }",
+                i ? "," : "", results[i].name.data(), results[i].iterations, sorted.front(), median, mean, stddev, sorted.back(), median / results[i].iterations);
+    }
+    fprintf(fp, "\n  ]\n}\n");
+}
+
+static void printUsage(const char* program)
+{
+    fprintf(stderr, "Usage: %s [--filter=<substring>] [--samples=<count>] [--warmup=<count>] [--output=<file>] [--cache-dir=<dir>] [--list]\n", program);
+}
+
+int main(int argc, char* argv[])
+{
+    BenchmarkOptions options;
+    bool listOnly = false;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strncmp(arg, "--filter=", 9) == 0) {
+            options.filter = arg + 9;
+        } else if (strncmp(arg, "--samples=", 10) == 0) {
+            options.samples = std::max(1, atoi(arg + 10));
+        } else if (strncmp(arg, "--warmup=", 9) == 0) {
+            options.warmup = std::max(0, atoi(arg + 9));
+        } else if (strncmp(arg, "--output=", 9) == 0) {
+            options.output = arg + 9;
+        } else if (strncmp(arg, "--cache-dir=", 12) == 0) {
+            options.cacheDir = arg + 12;
+        } else if (strcmp(arg, "--list") == 0) {
+            listOnly = true;
+        } else {
+            printUsage(argv[0]);
+            return 1;
+        }
+    }
+
+    auto selected = [&](const char* name) -> bool {
+        return options.filter.empty() || strstr(name, options.filter.data());
+    };
+
+    if (listOnly) {
+        for (const ScriptBenchmark& bench : s_scriptBenchmarks) {
+            puts(bench.name);
+        }
+        puts(Globals::supportsCodeCache() ? "codecache.load" : "codecache.load (unavailable: build with -DESCARGOT_CODE_CACHE=ON)");
+        return 0;
+    }
+
+    Globals::initialize(new BenchmarkPlatform());
+
+    std::vector<BenchmarkResult> results;
+    bool failed = false;
+
+    {
+        PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create();
+        for (const ScriptBenchmark& bench : s_scriptBenchmarks) {
+            if (!selected(bench.name)) {
+                continue;
+            }
+            fprintf(stderr, "running %s\n", bench.name);
+            BenchmarkResult result;
+            if (runScriptBenchmark(instance.get(), bench, options, result)) {
+                results.push_back(result);
+            } else {
+                fprintf(stderr, "%s failed\n", bench.name);
+                failed = true;
+            }
+        }
+        instance.release();
+    }
+
+    if (selected("codecache.load") && !Globals::supportsCodeCache()) {
+        // without code cache the benchmark would only measure parsing again
+        fprintf(stderr, "skipping codecache.load: escargot is built without -DESCARGOT_CODE_CACHE=ON\n");
+    } else if (selected("codecache.load")) {
+        fprintf(stderr, "running codecache.load\n");
+        BenchmarkResult result;
+        if (runCodeCacheBenchmark(options, result)) {
+            results.push_back(result);
+        } else {
+            fprintf(stderr, "codecache.load failed\n");
+            failed = true;
+        }
+    }
+
+    Globals::finalize();
+
+    FILE* fp = stdout;
+    if (options.output.length()) {
+        fp = fopen(options.output.data(), "w");
+        if (!fp) {
+            fprintf(stderr, "cannot open %s\n", options.output.data());
+            return 1;
+        }
+    }
+    writeResults(fp, results, options);
+    if (fp != stdout) {
+        fclose(fp);
+    }
+
+    return failed ? 1 : 0;
+}
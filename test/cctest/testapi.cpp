@@ -24,6 +24,11 @@ using namespace Escargot;
 #include "gtest/gtest.h"
 
 #include <vector>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sys/stat.h>
+#include <unistd.h>
 
 static bool stringEndsWith(const std::string& str, const std::string& suffix)
 {
@@ -1516,6 +1521,244 @@ TEST(PromiseHook, Basic2)
     });
 }
 
+TEST(JobQueue, Statistics)
+{
+    g_instance.get()->resetJobQueueStatistics();
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var r = 0; for (var i = 0; i < 300; i++) { Promise.resolve(i).then((v) => { r += v; }); } (async () => { await 1; await 2; r++; })(); r"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "0");
+
+    auto statistics = g_instance.get()->jobQueueStatistics();
+    EXPECT_EQ(statistics.pendingJobCount, 0u);
+    EXPECT_EQ(statistics.peakPendingJobCount, 301u);
+    EXPECT_EQ(statistics.executedJobCount, 302u);
+    EXPECT_EQ(statistics.drainCount, 1u);
+    EXPECT_EQ(statistics.lastDrainJobCount, 302u);
+    EXPECT_EQ(statistics.maxDrainJobCount, 302u);
+
+    s = evalScript(g_context.get(), StringRef::createFromASCII("r"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "44851");
+}
+
+TEST(VMInstance, StackTraceDepthLimit)
+{
+    size_t oldLimit = g_instance.get()->stackTraceDepthLimit();
+    const char* src = "function f(n) { if (n == 0) throw new Error('e'); f(n - 1); }"
+                      "var depth = 0; try { f(10); } catch (e) { depth = e.stack.match(/at test\\.js/g).length; } depth";
+
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "12");
+
+    g_instance.get()->setStackTraceDepthLimit(3);
+    EXPECT_EQ(g_instance.get()->stackTraceDepthLimit(), 3u);
+    s = evalScript(g_context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "3");
+
+    g_instance.get()->setStackTraceDepthLimit(oldLimit);
+}
+
+TEST(VMInstance, SamplingProfiler)
+{
+    if (!g_instance.get()->startSamplingProfiler(100)) {
+        // escargot is built without sampling profiler
+        EXPECT_FALSE(g_instance.get()->isSamplingProfilerRunning());
+        EXPECT_FALSE(g_instance.get()->stopSamplingProfiler(nullptr));
+        return;
+    }
+    EXPECT_TRUE(g_instance.get()->isSamplingProfilerRunning());
+    EXPECT_FALSE(g_instance.get()->startSamplingProfiler(100));
+
+    const char* src = "function hot(n) { var s = 0; for (var i = 0; i < n; i++) { s += i; } return s; }"
+                      "var r = 0; for (var j = 0; j < 200; j++) { r += hot(10000); } r > 0";
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("profile.js"), false);
+    EXPECT_EQ(s, "true");
+
+    const char* path = "/tmp/escargot-cctest.cpuprofile";
+    EXPECT_TRUE(g_instance.get()->stopSamplingProfiler(path));
+    EXPECT_FALSE(g_instance.get()->isSamplingProfilerRunning());
+
+    std::ifstream file(path);
+    std::string profile((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(profile.find("\"samples\":["), std::string::npos);
+    EXPECT_NE(profile.find("\"url\":\"profile.js\""), std::string::npos);
+    remove(path);
+
+    // callers deeper than the depth limit are put under synthetic node instead of root
+    EXPECT_TRUE(g_instance.get()->startSamplingProfiler(100));
+    src = "function deep(d) { if (d) { return deep(d - 1); } var s = 0; for (var i = 0; i < 2000000; i++) { s += i; } return s; } deep(100) > 0";
+    s = evalScript(g_context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("profile-deep.js"), false);
+    EXPECT_EQ(s, "true");
+    EXPECT_TRUE(g_instance.get()->stopSamplingProfiler(path));
+
+    std::ifstream deepFile(path);
+    profile = std::string((std::istreambuf_iterator<char>(deepFile)), std::istreambuf_iterator<char>());
+    EXPECT_NE(profile.find("\"functionName\":\"(truncated)\""), std::string::npos);
+    remove(path);
+}
+
+TEST(VMInstance, AllocationSampler)
+{
+    if (!g_instance.get()->startAllocationSampler(1)) {
+        // escargot is built without sampling profiler
+        EXPECT_FALSE(g_instance.get()->isAllocationSamplerRunning());
+        EXPECT_FALSE(g_instance.get()->stopAllocationSampler(nullptr));
+        return;
+    }
+    EXPECT_TRUE(g_instance.get()->isAllocationSamplerRunning());
+
+    const char* src = "function make() { return { a: 1 }; } var arr = []; for (var i = 0; i < 100; i++) { arr.push(make()); } arr.length";
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("alloc.js"), false);
+    EXPECT_EQ(s, "100");
+
+    const char* path = "/tmp/escargot-cctest.allocations.json";
+    EXPECT_TRUE(g_instance.get()->stopAllocationSampler(path));
+    EXPECT_FALSE(g_instance.get()->isAllocationSamplerRunning());
+
+    std::ifstream file(path);
+    std::string profile((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(profile.find("\"functionName\":\"make\""), std::string::npos);
+    remove(path);
+}
+
+TEST(VMInstance, InterpreterStatistics)
+{
+    if (!g_instance.get()->resetInterpreterStatistics()) {
+        // escargot is built without interpreter statistics
+        EXPECT_FALSE(g_instance.get()->dumpInterpreterStatistics(nullptr));
+        return;
+    }
+
+    const char* src = "function point(x) { return { x: x }; } var sum = 0; for (var i = 0; i < 100; i++) { sum += point(i).x; } sum";
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("statistics.js"), false);
+    EXPECT_EQ(s, "4950");
+
+    const char* path = "/tmp/escargot-cctest.statistics.txt";
+    EXPECT_TRUE(g_instance.get()->dumpInterpreterStatistics(path));
+
+    std::ifstream file(path);
+    std::string statistics((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(statistics.find("GetObjectPreComputedCase"), std::string::npos);
+    EXPECT_NE(statistics.find("point (statistics.js:1:"), std::string::npos);
+    remove(path);
+}
+
+TEST(VMInstance, IntlFormatterCache)
+{
+    PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create("en-US");
+    PersistentRefHolder<ContextRef> context = createEscargotContext(instance.get());
+
+    const char* src = "(1234.5).toLocaleString('en-US')";
+    auto s = evalScript(context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("intl.js"), false);
+    if (instance.get()->intlFormatterCacheSize() == 0) {
+        // escargot is built without Intl
+        context.release();
+        instance.release();
+        return;
+    }
+    EXPECT_EQ(s, "1,234.5");
+    EXPECT_EQ(instance.get()->intlFormatterCacheSize(), 1u);
+
+    // same kind and locale hits the cache
+    s = evalScript(context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("intl.js"), false);
+    EXPECT_EQ(s, "1,234.5");
+    EXPECT_EQ(instance.get()->intlFormatterCacheSize(), 1u);
+
+    src = "(1234.5).toLocaleString('de-DE')";
+    s = evalScript(context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("intl.js"), false);
+    EXPECT_EQ(s, "1.234,5");
+    EXPECT_EQ(instance.get()->intlFormatterCacheSize(), 2u);
+
+    // options are read on every call and formatters made with them are not cached
+    src = "var reads = 0; var options = { get minimumFractionDigits() { reads++; return 2; } };"
+          "var first = (1234.5).toLocaleString('en-US', options); var firstReads = reads;"
+          "var second = (1234.5).toLocaleString('en-US', options);"
+          "first + '|' + second + '|' + (firstReads > 0 && reads === firstReads * 2) + '|' + (1234.5).toLocaleString('en-US')";
+    s = evalScript(context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("intl.js"), false);
+    EXPECT_EQ(s, "1,234.50|1,234.50|true|1,234.5");
+    EXPECT_EQ(instance.get()->intlFormatterCacheSize(), 2u);
+
+    // other kinds with the same locale get their own entry
+    src = "'a'.localeCompare('b', 'en-US') + '|' + 'b'.localeCompare('a', 'en-US') + '|' + (1234.5).toLocaleString('en-US')";
+    s = evalScript(context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("intl.js"), false);
+    EXPECT_EQ(s, "-1|1|1,234.5");
+    EXPECT_EQ(instance.get()->intlFormatterCacheSize(), 3u);
+
+    // cached formatters belong to a context, so they go away with other context related caches
+    instance.get()->clearCachesRelatedWithContext();
+    EXPECT_EQ(instance.get()->intlFormatterCacheSize(), 0u);
+
+    src = "(1234.5).toLocaleString('de-DE')";
+    s = evalScript(context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("intl.js"), false);
+    EXPECT_EQ(s, "1.234,5");
+    EXPECT_EQ(instance.get()->intlFormatterCacheSize(), 1u);
+
+    context.release();
+    instance.release();
+}
+
+TEST(VMInstance, TimezoneOffsetCache)
+{
+    PersistentRefHolder<VMInstanceRef> instance = VMInstanceRef::create("en-US", "America/New_York");
+    PersistentRefHolder<ContextRef> context = createEscargotContext(instance.get());
+
+    // cached offset ranges are extended by up to 19 days, so walk both ways across each transition
+    // and jump from one side to the other by less than the extension
+    const char* src = "var springForward = Date.UTC(2021, 2, 14, 7); var fallBack = Date.UTC(2021, 10, 7, 6);"
+                      "var day = 86400000; var hour = 3600000; var errors = 0;"
+                      "function check(t) { if (new Date(t).getTimezoneOffset() !== (t >= springForward && t < fallBack ? 240 : 300)) { errors++; } }"
+                      "[springForward, fallBack].forEach(function (transition) {"
+                      "    for (var t = transition - 30 * day; t <= transition + 30 * day; t += 7 * hour) { check(t); }"
+                      "    for (var t = transition + 30 * day; t >= transition - 30 * day; t -= 7 * hour) { check(t); }"
+                      "    for (var i = 0; i < 40; i++) { check(transition - 18 * day + i * hour); check(transition + 18 * day - i * hour); }"
+                      "    check(transition - 1); check(transition); check(transition - 1);"
+                      "});"
+                      "errors + '|' + new Date(springForward - 1).getHours() + '|' + new Date(springForward).getHours() + '|' + new Date(fallBack - 1).getHours() + '|' + new Date(fallBack).getHours()";
+    auto s = evalScript(context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("timezone.js"), false);
+    EXPECT_EQ(s, "0|1|3|1|1");
+
+    context.release();
+    instance.release();
+}
+
+TEST(Context, HeapSnapshot)
+{
+    const char* src = "var heapSnapshotTestValue = { heapSnapshotTestProperty: [1, 2, 3] }; var heapSnapshotTestRope = 'heapSnapshotRopeLeft_'; heapSnapshotTestRope += 'heapSnapshotRopeRight'; heapSnapshotTestValue['heapSnapshot\"Escaped\\nKey'] = 1; true";
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("snapshot.js"), false);
+    EXPECT_EQ(s, "true");
+
+    const char* path = "/tmp/escargot-cctest.heapsnapshot";
+    EXPECT_TRUE(g_context.get()->writeHeapSnapshot(path));
+
+    std::ifstream file(path);
+    std::string snapshot((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_NE(snapshot.find("\"snapshot\":"), std::string::npos);
+    EXPECT_NE(snapshot.find("\"heapSnapshotTestValue\""), std::string::npos);
+    EXPECT_NE(snapshot.find("\"heapSnapshotTestProperty\""), std::string::npos);
+    EXPECT_NE(snapshot.find("\"heapSnapshotRopeLeft_heapSnapshotRopeRight\""), std::string::npos);
+    EXPECT_NE(snapshot.find("\"heapSnapshot\\\"Escaped\\u000aKey\""), std::string::npos);
+    remove(path);
+}
+
+TEST(Memory, OldToYoungReference)
+{
+    // generational gc mode should find pointers stored into old objects after they are marked
+    const char* src = "var gcTestOld = { items: [] }; var gcTestArray = []; for (var i = 0; i < 10000; i++) { gcTestArray.push({ v: i }); } true";
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("gc.js"), false);
+    EXPECT_EQ(s, "true");
+    Memory::gc();
+
+    src = "for (var i = 0; i < 1000; i++) { gcTestOld.items.push({ v: i }); gcTestArray[i] = { v: i * 2 }; gcTestOld['p' + i] = [i]; }"
+          "for (var i = 0; i < 200000; i++) { var garbage = { a: [i], b: 'x' + i }; } true";
+    s = evalScript(g_context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("gc.js"), false);
+    EXPECT_EQ(s, "true");
+
+    src = "var sum = 0; for (var i = 0; i < 1000; i++) { sum += gcTestOld.items[i].v + gcTestArray[i].v + gcTestOld['p' + i][0]; } sum";
+    s = evalScript(g_context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("gc.js"), false);
+    EXPECT_EQ(s, "1998000");
+    Memory::gc();
+    s = evalScript(g_context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("gc.js"), false);
+    EXPECT_EQ(s, "1998000");
+}
+
 TEST(Serializer, Basic1)
 {
     std::ostringstream ostream;
@@ -1610,6 +1853,192 @@ TEST(Serializer, Basic9)
     EXPECT_TRUE(v2->asString()->equals(v1->asString()));
 }
 
+TEST(ArrayObject, ElementKindTransition)
+{
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("var a = [1, 2, 3]; a[1] = 1.5; var r = a.join(); a[2] = 'x'; r + '|' + a.join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "1,1.5,3|1,1.5,x");
+
+    s = evalScript(g_context.get(), StringRef::createFromASCII("var b = [1, , 3]; var r = [1 in b]; b[3] = 0.5; r.push(1 in b, b.length, b.join()); r.join('|')"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "false|false|4|1,,3,0.5");
+
+    s = evalScript(g_context.get(), StringRef::createFromASCII("var c = [1, 2]; c[0] = -2147483648; c[1] = 2147483647; var d = [1]; d[0] = -0; c.join() + '|' + (1 / d[0])"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "-2147483648,2147483647|-Infinity");
+
+    s = evalScript(g_context.get(), StringRef::createFromASCII("var e = [1.5]; e[0] = NaN; e[1] = 2; [isNaN(e[0]), 0 in e, e.length].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "true,true,2");
+
+    s = evalScript(g_context.get(), StringRef::createFromASCII("var f = [1.5, 2.5, 3.5]; f.length = 1; f.length = 3; var g = [1, 2, 3]; g.length = 0; g.push(4); [String(f[1]), 1 in f, f.join(), g.join()].join('|')"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "undefined|false|1.5,,|4");
+}
+
+TEST(TypedArrayObject, IndexedAccess)
+{
+    // get and set through function arguments run GetObject and SetObjectOperation with fast path
+    const char* src = "function get(a, i) { return a[i]; }"
+                      "function set(a, i, v) { a[i] = v; }"
+                      "var r = [];"
+                      "var i8 = new Int8Array(4);"
+                      "for (var k = 0; k < 4; k++) set(i8, k, k * 100);"
+                      "r.push(i8.join(), get(i8, 3), String(get(i8, 4)), String(get(i8, 100)));"
+                      "set(i8, 4, 1); r.push(i8.length, String(i8[4]), Object.keys(i8).length);"
+                      "var sub = new Uint16Array(new Uint16Array([1, 2, 3, 4]).buffer, 4); set(sub, 1, 9); r.push(get(sub, 0), get(sub, 1), String(get(sub, 2)));"
+                      "var f32 = new Float32Array(2); set(f32, 0, 1.1); set(f32, 1, NaN); r.push(get(f32, 0), get(f32, 1));"
+                      "var c = new Uint8ClampedArray(4); set(c, 0, 300); set(c, 1, -5); set(c, 2, 1.5); set(c, 3, 2.5); r.push(c.join());"
+                      "var b = new BigInt64Array(2); set(b, 0, 9223372036854775807n); set(b, 1, 2n ** 64n - 1n); r.push(String(get(b, 0)), String(get(b, 1)), typeof get(b, 0));"
+                      "try { set(b, 0, 1); r.push('no error'); } catch (e) { r.push(e.name); }"
+                      "var buf = new ArrayBuffer(8); var u32 = new Uint32Array(buf); set(u32, 0, 7); buf.transfer();"
+                      "r.push(String(get(u32, 0)), u32.length); set(u32, 0, 1); r.push(String(u32[0]));"
+                      "var count = 0; var obj = { valueOf() { count++; return 5; } };"
+                      "var u8 = new Uint8Array(2); set(u8, 0, obj); set(u8, 5, obj); r.push(get(u8, 0), count);"
+                      "r.join('|')";
+
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "0,100,-56,44|44|undefined|undefined|4|undefined|4|3|9|undefined|1.100000023841858|NaN|255,0,2,2|9223372036854775807|-1|bigint|TypeError|undefined|0|undefined|5|2");
+}
+
+TEST(BigInt, Int64Boundary)
+{
+    Evaluator::execute(g_context.get(), [](ExecutionStateRef* state) -> ValueRef* {
+        const int64_t max = std::numeric_limits<int64_t>::max();
+        const int64_t min = std::numeric_limits<int64_t>::min();
+        BigIntRef* maxValue = BigIntRef::create(max);
+        BigIntRef* minValue = BigIntRef::create(min);
+        BigIntRef* one = BigIntRef::create(static_cast<int64_t>(1));
+        BigIntRef* minusOne = BigIntRef::create(static_cast<int64_t>(-1));
+
+        // results inside int64 range
+        EXPECT_EQ(maxValue->addition(state, minValue)->toInt64(), -1);
+        EXPECT_EQ(maxValue->subtraction(state, maxValue)->toInt64(), 0);
+        EXPECT_EQ(minValue->subtraction(state, minusOne)->toInt64(), min + 1);
+        EXPECT_EQ(maxValue->multiply(state, minusOne)->toInt64(), -max);
+        EXPECT_EQ(maxValue->negativeValue(state)->toInt64(), -max);
+
+        // overflowed results are promoted to libbf
+        BigIntRef* overMax = maxValue->addition(state, one);
+        EXPECT_EQ(overMax->toString()->toStdUTF8String(), "9223372036854775808");
+        EXPECT_EQ(overMax->toUint64(), static_cast<uint64_t>(max) + 1);
+        EXPECT_EQ(overMax->toInt64(), min);
+        EXPECT_TRUE(overMax->greaterThan(maxValue));
+        BigIntRef* underMin = minValue->subtraction(state, one);
+        EXPECT_EQ(underMin->toString()->toStdUTF8String(), "-9223372036854775809");
+        EXPECT_TRUE(underMin->lessThan(minValue));
+        EXPECT_EQ(maxValue->subtraction(state, minValue)->toString()->toStdUTF8String(), "18446744073709551615");
+        EXPECT_EQ(minValue->multiply(state, minusOne)->toString()->toStdUTF8String(), "9223372036854775808");
+        EXPECT_EQ(minusOne->multiply(state, minValue)->toString()->toStdUTF8String(), "9223372036854775808");
+        EXPECT_EQ(maxValue->multiply(state, maxValue)->toString()->toStdUTF8String(), "85070591730234615847396907784232501249");
+        BigIntRef* negatedMin = minValue->negativeValue(state);
+        EXPECT_EQ(negatedMin->toString()->toStdUTF8String(), "9223372036854775808");
+
+        // libbf results which fit in int64 again are demoted
+        BigIntRef* backToMax = overMax->subtraction(state, one);
+        EXPECT_TRUE(backToMax->equals(maxValue));
+        EXPECT_EQ(backToMax->toInt64(), max);
+        EXPECT_EQ(backToMax->addition(state, minValue)->toInt64(), -1);
+        BigIntRef* backToMin = underMin->addition(state, one);
+        EXPECT_TRUE(backToMin->equals(minValue));
+        EXPECT_EQ(backToMin->toInt64(), min);
+        EXPECT_EQ(negatedMin->negativeValue(state)->toInt64(), min);
+        EXPECT_EQ(maxValue->subtraction(state, minValue)->addition(state, minValue)->toInt64(), max);
+        EXPECT_EQ(maxValue->multiply(state, maxValue)->division(state, maxValue)->toInt64(), max);
+        return ValueRef::createUndefined();
+    });
+
+    const char* src = "var max = 2n ** 63n - 1n; var min = -(2n ** 63n); var a = new BigInt64Array(1); a[0] = max + 1n - 1n;"
+                      "[max + 1n, min - 1n, max + 1n - 1n === max, -min, -(-min) === min, min * -1n, min / -1n, max - min + min === max, min + max, a[0] === max].join()";
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "9223372036854775808,-9223372036854775809,true,9223372036854775808,true,9223372036854775808,9223372036854775808,true,-1,true");
+}
+
+TEST(EnumerateObject, KeyCache)
+{
+    // objects made by same function share structure, so later for-in can hit key cache of former one
+    const char* src = "function keys(o) { var r = []; for (var k in o) r.push(k); return r.join(); }"
+                      "function make() { return { a: 1, b: 2 }; }"
+                      "var r = [keys(make()), keys(make())];"
+                      "var o1 = make(); o1.c = 3; r.push(keys(o1));"
+                      "var o2 = make(); delete o2.a; r.push(keys(o2), keys(make()));"
+                      "var o3 = make(); Object.defineProperty(o3, 'a', { enumerable: false }); r.push(keys(o3));"
+                      "var proto = { p: 1 };"
+                      "var o4 = make(); Object.setPrototypeOf(o4, proto); r.push(keys(o4));"
+                      "proto.q = 2; r.push(keys(o4));"
+                      "var o5 = make(); Object.setPrototypeOf(o5, proto); r.push(keys(o5));"
+                      "Object.setPrototypeOf(o5, { z: 1 }); r.push(keys(o5));"
+                      "delete proto.p; r.push(keys(o4), keys(make()));"
+                      "function makeIndexed() { return { b: 1, 2: 'x', a: 1, 1: 'y' }; }"
+                      "r.push(keys(makeIndexed()), keys(makeIndexed()));"
+                      "var o6 = makeIndexed(); o6[0] = 1; r.push(keys(o6));"
+                      "var base = { a: 0, x: 1 }; var o7 = Object.create(base); o7.a = 1; r.push(keys(o7));"
+                      "base.y = 1; r.push(keys(o7));"
+                      "var empty = {}; function makeWithProto() { var o = Object.create(empty); o.a = 1; return o; }"
+                      "r.push(keys(makeWithProto()), keys(makeWithProto()));"
+                      "empty.e = 1; r.push(keys(makeWithProto()));"
+                      "Object.defineProperty(empty, 'e', { enumerable: false }); r.push(keys(makeWithProto()));"
+                      "r.join('|')";
+
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "a,b|a,b|a,b,c|b|a,b|b|a,b,p|a,b,p,q|a,b,p,q|a,b,z|a,b,q|a,b|1,2,b,a|1,2,b,a|0,1,2,b,a|a,x|a,x,y|a|a|a,e|a");
+}
+
+TEST(Module, ImportBinding)
+{
+    const char* dir = "/tmp/escargot-cctest-module";
+    const char* modules[][2] = {
+        { "counter.mjs",
+          "export let count = 0;\n"
+          "export function increment() { count++; }\n"
+          "export function reset() { count = 0; }\n"
+          "export default function named() {}\n" },
+        { "reexport.mjs",
+          "export * from './counter.mjs';\n"
+          "export { count as renamedCount, increment as renamedIncrement } from './counter.mjs';\n" },
+        { "cycle-a.mjs",
+          "import { b, readA, accessBeforeInit } from './cycle-b.mjs';\n"
+          "export let a = 'a';\n"
+          "export const fromB = b + readA() + accessBeforeInit;\n" },
+        { "cycle-b.mjs",
+          "import { a } from './cycle-a.mjs';\n"
+          "export let b = 'b';\n"
+          "export let accessBeforeInit = 'none';\n"
+          "try { a; } catch (e) { accessBeforeInit = e.constructor.name; }\n"
+          "export function readA() { return a; }\n" },
+        { "main.mjs",
+          "import { count, increment } from './counter.mjs';\n"
+          "import * as ns from './counter.mjs';\n"
+          "import { count as reexportedCount, renamedCount, renamedIncrement } from './reexport.mjs';\n"
+          "import * as reexportNs from './reexport.mjs';\n"
+          "import { fromB } from './cycle-a.mjs';\n"
+          "import { readA, accessBeforeInit } from './cycle-b.mjs';\n"
+          "function readCount() { return count; }\n"
+          "var r = [count, ns.count, reexportedCount, renamedCount];\n"
+          "increment();\n"
+          "r.push(count, readCount(), ns.count, reexportedCount, renamedCount, reexportNs.count, reexportNs.renamedCount);\n"
+          "renamedIncrement();\n"
+          "r.push(count, renamedCount);\n"
+          "ns.reset();\n"
+          "r.push(count, readCount(), typeof ns.default, Object.keys(reexportNs).join(':'));\n"
+          "r.push(fromB, readA(), accessBeforeInit);\n"
+          "globalThis.moduleTestResult = r.join();\n" },
+    };
+    mkdir(dir, 0755);
+    for (auto& module : modules) {
+        std::ofstream file(std::string(dir) + "/" + module[0]);
+        file << module[1];
+    }
+
+    // imported bindings are live, through re-exports and namespaces too, and hit TDZ inside a cycle
+    std::string mainPath = std::string(dir) + "/main.mjs";
+    const char* mainSource = modules[sizeof(modules) / sizeof(modules[0]) - 1][1];
+    evalScript(g_context.get(), StringRef::createFromASCII(mainSource, strlen(mainSource)), StringRef::createFromASCII(mainPath.data(), mainPath.length()), true);
+    const char* src = "moduleTestResult";
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "0,0,0,0,1,1,1,1,1,1,1,2,2,0,0,function,count:increment:renamedCount:renamedIncrement:reset,baReferenceError,a,ReferenceError");
+
+    for (auto& module : modules) {
+        remove((std::string(dir) + "/" + module[0]).data());
+    }
+    rmdir(dir);
+}
+
 TEST(ExecutionState, TryCatchFinally)
 {
     Evaluator::execute(g_context, [](ExecutionStateRef* state) -> ValueRef* {
@@ -1650,6 +2079,35 @@ TEST(ExecutionState, TryCatchFinally)
     evalScript(g_context.get(), StringRef::createFromASCII("try { tryCatchTest(1); throw 1; } catch(e) { tryCatchTest(2) } finally{ tryCatchTest(3) }"), StringRef::createFromASCII("test.js"), false);
 }
 
+TEST(ExecutionState, ThrowInTry)
+{
+    // throw in try body of the same frame is caught without C++ unwinding
+    // results should be the same with the unwinding path (nested block, callee)
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII("try { 1; throw 2; } catch (e) { e + 10 }"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "12");
+    s = evalScript(g_context.get(), StringRef::createFromASCII("try { { let x = 3; throw x; } } catch (e) { e + 10 }"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "13");
+    s = evalScript(g_context.get(), StringRef::createFromASCII("var c = 0; try { c++; throw c; } catch (e) { c += e; } finally { c *= 10; } c"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "20");
+    s = evalScript(g_context.get(), StringRef::createFromASCII("try { try { throw 1; } finally { 5; } } catch (e) { e }"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "1");
+    s = evalScript(g_context.get(), StringRef::createFromASCII("function t() { try { throw 'x'; } catch (e) { return e + 'y'; } } t()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "xy");
+
+    s = evalScript(g_context.get(), StringRef::createFromASCII("function* g() { try { yield 1; throw 2; } catch (e) { yield e; } finally { yield 3; } } var it = g(); [it.next().value, it.next().value, it.next().value, it.next().done].join()"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "1,2,3,true");
+
+    evalScript(g_context.get(), StringRef::createFromASCII("var asyncResult; (async function() { try { await 0; throw 5; } catch (e) { asyncResult = e; } finally { asyncResult += 1; } })()"), StringRef::createFromASCII("test.js"), false);
+    s = evalScript(g_context.get(), StringRef::createFromASCII("asyncResult"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, "6");
+
+    // throw statements are at the same position. only the first one takes the fast path
+    auto fast = evalScript(g_context.get(), StringRef::createFromASCII("try {          throw 1; } finally { }"), StringRef::createFromASCII("test.js"), false);
+    auto unwound = evalScript(g_context.get(), StringRef::createFromASCII("try { { let x; throw 1; } } finally { }"), StringRef::createFromASCII("test.js"), false);
+    EXPECT_TRUE(fast.find("Uncaught 1:\ntest.js (1:") == 0);
+    EXPECT_EQ(fast, unwound);
+}
+
 TEST(IteratorObject, GenericIterator)
 {
     std::vector<int> sampleData = { 0, 1, 2 };
@@ -1691,6 +2149,43 @@ TEST(IteratorObject, GenericIterator)
                StringRef::createFromASCII("test.js"), false);
 }
 
+TEST(CompressibleString, DecompressedWindow)
+{
+    if (!StringRef::isCompressibleStringEnabled()) {
+        return;
+    }
+
+    std::string source;
+    for (size_t i = 0; i < 512 * 1024; i++) {
+        source += (char)('a' + (i / 1000) % 26);
+    }
+    StringRef* string = StringRef::createFromASCIIToCompressibleString(g_context->vmInstance(), source.data(), source.length());
+    // compress string
+    g_context->vmInstance()->enterIdleMode();
+
+    Evaluator::execute(g_context, [](ExecutionStateRef* state, StringRef* string) -> ValueRef* {
+        state->context()->globalObject()->set(state, StringRef::createFromASCII("compressedString"), string);
+        return ValueRef::createUndefined();
+    },
+                       string);
+
+    // each piece is read from other window while previous pieces are still being copied
+    std::string expected;
+    for (size_t i = 0; i < 8; i++) {
+        expected += (i ? "," : "") + source.substr(i * 65536, 3);
+    }
+    expected += "|" + source.substr(10, 10) + source.substr(400000, 10);
+    const char* src = "var parts = []; for (var i = 0; i < 8; i++) { parts.push(compressedString.substring(i * 65536, i * 65536 + 3)); }"
+                      "parts.join() + '|' + (compressedString.substring(10, 20) + compressedString.substring(400000, 400010))";
+    auto s = evalScript(g_context.get(), StringRef::createFromASCII(src, strlen(src)), StringRef::createFromASCII("test.js"), false);
+    EXPECT_EQ(s, expected);
+
+    // windows are released at idle time and decompressed again on next access
+    g_context->vmInstance()->enterIdleMode();
+    EXPECT_EQ(string->charAt(300000), source[300000]);
+    EXPECT_EQ(string->charAt(10), source[10]);
+}
+
 TEST(ReloadableString, Basic)
 {
     char reloadableStringTestSource[] = "let x = 'test String'";